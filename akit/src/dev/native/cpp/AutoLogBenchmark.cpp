@@ -0,0 +1,174 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <array>
+#include <frc/geometry/Pose2d.h>
+
+#include "Benchmark.h"
+#include "akit/AutoLogOutputManager.h"
+#include "akit/inputs/AutoLogInputs.h"
+
+using namespace akit;
+using akit::bench::Measure;
+
+namespace {
+
+constexpr size_t MODULE_COUNT = 4;
+
+struct Module {
+	double drivePosition = 0;
+	double driveVelocity = 0;
+	double turnAngle = 0;
+	double current = 0;
+
+	double GetDriveVelocity() const {
+		return driveVelocity;
+	}
+};
+
+struct Drive {
+	std::array<Module, MODULE_COUNT> modules;
+	frc::Pose2d pose;
+
+	frc::Pose2d GetPose() const {
+		return pose;
+	}
+
+	// Changes every value so each write is a real change
+	void Update(double time) {
+		for (Module &module : modules) {
+			module.drivePosition = time;
+			module.driveVelocity = time * 2;
+			module.turnAngle = time * 3;
+			module.current = time * 4;
+		}
+		pose = frc::Pose2d { units::meter_t { time }, units::meter_t { time },
+				frc::Rotation2d { } };
+	}
+};
+
+}
+
+AKIT_BENCHMARK(AutoLogOutputPoll) {
+	Drive drive;
+	double time = 0;
+
+	// Outputs written by hand each cycle, building each key as a string
+	LogTable manualTable { 0_s };
+	LogTable manualOutputs = manualTable.GetSubtable("RealOutputs");
+	Measure("17 outputs by hand", 100000, [&] {
+		drive.Update(time += 0.02);
+		for (size_t i = 0; i < MODULE_COUNT; i++) {
+			std::string prefix = "Drive/Module" + std::to_string(i) + "/";
+			const Module &module = drive.modules[i];
+			manualOutputs.Put(prefix + "DrivePosition", module.drivePosition);
+			manualOutputs.Put(prefix + "DriveVelocity",
+					module.GetDriveVelocity());
+			manualOutputs.Put(prefix + "TurnAngle", module.turnAngle);
+			manualOutputs.Put(prefix + "Current", module.current);
+		}
+		manualOutputs.Put("Drive/Pose", drive.GetPose());
+	});
+
+	LogTable autoTable { 0_s };
+	AutoLogOutputManager manager { autoTable.GetSubtable("RealOutputs") };
+	for (size_t i = 0; i < MODULE_COUNT; i++) {
+		std::string prefix = "Drive/Module" + std::to_string(i) + "/";
+		const Module &module = drive.modules[i];
+		manager.Register(prefix + "DrivePosition", module,
+				&Module::drivePosition);
+		manager.Register(prefix + "DriveVelocity", module,
+				&Module::GetDriveVelocity);
+		manager.Register(prefix + "TurnAngle", module, &Module::turnAngle);
+		manager.Register(prefix + "Current", module, &Module::current);
+	}
+	manager.Register("Drive/Pose", drive, &Drive::GetPose);
+	Measure("17 outputs by AutoLogOutputManager", 100000, [&] {
+		drive.Update(time += 0.02);
+		manager.Poll();
+	});
+}
+
+namespace {
+
+class ModuleInputs: public inputs::LoggableInputs {
+public:
+	double drivePosition = 0;
+	double driveVelocity = 0;
+	double driveAppliedVolts = 0;
+	double driveCurrent = 0;
+	double turnPosition = 0;
+	double turnVelocity = 0;
+	double turnAppliedVolts = 0;
+	double turnCurrent = 0;
+	bool driveConnected = true;
+	bool turnConnected = true;
+};
+
+// Hand-written, as every inputs class was before AKIT_AUTOLOG_INPUTS
+class ManualModuleInputs: public ModuleInputs {
+public:
+	void ToLog(LogTable &&table) override {
+		table.Put("DrivePosition", drivePosition);
+		table.Put("DriveVelocity", driveVelocity);
+		table.Put("DriveAppliedVolts", driveAppliedVolts);
+		table.Put("DriveCurrent", driveCurrent);
+		table.Put("TurnPosition", turnPosition);
+		table.Put("TurnVelocity", turnVelocity);
+		table.Put("TurnAppliedVolts", turnAppliedVolts);
+		table.Put("TurnCurrent", turnCurrent);
+		table.Put("DriveConnected", driveConnected);
+		table.Put("TurnConnected", turnConnected);
+	}
+
+	void FromLog(LogTable &&table) override {
+		drivePosition = table.Get("DrivePosition", drivePosition);
+		driveVelocity = table.Get("DriveVelocity", driveVelocity);
+		driveAppliedVolts = table.Get("DriveAppliedVolts", driveAppliedVolts);
+		driveCurrent = table.Get("DriveCurrent", driveCurrent);
+		turnPosition = table.Get("TurnPosition", turnPosition);
+		turnVelocity = table.Get("TurnVelocity", turnVelocity);
+		turnAppliedVolts = table.Get("TurnAppliedVolts", turnAppliedVolts);
+		turnCurrent = table.Get("TurnCurrent", turnCurrent);
+		driveConnected = table.Get("DriveConnected", driveConnected);
+		turnConnected = table.Get("TurnConnected", turnConnected);
+	}
+};
+
+class GeneratedModuleInputs: public ModuleInputs {
+	AKIT_AUTOLOG_INPUTS(drivePosition, driveVelocity, driveAppliedVolts,
+			driveCurrent, turnPosition, turnVelocity, turnAppliedVolts,
+			turnCurrent, driveConnected, turnConnected)
+};
+
+template<typename Inputs>
+void MeasureInputs(const std::string &name) {
+	std::array<Inputs, MODULE_COUNT> modules;
+	LogTable table { 0_s };
+	double time = 0;
+	Measure(name + " ToLog", 100000, [&] {
+		time += 0.02;
+		for (size_t i = 0; i < MODULE_COUNT; i++) {
+			modules[i].drivePosition = time;
+			modules[i].turnPosition = time * 2;
+			modules[i].ToLog(
+					table.GetSubtable("Drive/Module" + std::to_string(i)));
+		}
+	});
+	Measure(name + " FromLog", 100000, [&] {
+		for (size_t i = 0; i < MODULE_COUNT; i++)
+			modules[i].FromLog(
+					table.GetSubtable("Drive/Module" + std::to_string(i)));
+	});
+}
+
+}
+
+AKIT_BENCHMARK(AutoLogInputs) {
+	MeasureInputs<ManualModuleInputs>("4 modules by hand");
+	MeasureInputs<GeneratedModuleInputs>("4 modules by AKIT_AUTOLOG_INPUTS");
+}
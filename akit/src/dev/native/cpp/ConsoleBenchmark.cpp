@@ -0,0 +1,134 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "Benchmark.h"
+#include "akit/ConsoleSource.h"
+
+using namespace akit;
+using akit::bench::DoNotOptimize;
+using akit::bench::ReportRate;
+
+namespace {
+
+// A session prints 10 MB as four 50 byte lines per 20 ms cycle, about
+// 17 minutes of simulated time
+constexpr size_t SESSION_BYTES = 10 << 20;
+constexpr size_t LINES_PER_CYCLE = 4;
+const std::string LINE = std::string(49, 'x') + '\n';
+
+// Previous capture: one virtual call per character into an ostringstream,
+// with the whole history copied on every read
+class PreviousCapture: public std::streambuf {
+public:
+	std::string GetNewData() {
+		std::string full = captured.str();
+		std::string result = full.substr(position);
+		position = full.size();
+		return result;
+	}
+
+protected:
+	int overflow(int c) override {
+		if (c == EOF)
+			return !EOF;
+		captured.put(static_cast<char>(c));
+		return c;
+	}
+
+private:
+	std::ostringstream captured;
+	size_t position = 0;
+};
+
+// Prints bytes in cycles, reading new console data once per cycle.
+// Returns the throughput in MB/s.
+template<typename Print, typename Read>
+double MeasureSession(size_t bytes, Print &&print, Read &&read) {
+	size_t cycles = bytes / (LINE.size() * LINES_PER_CYCLE);
+	bytes = cycles * LINE.size() * LINES_PER_CYCLE;
+	size_t readBytes = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (size_t cycle = 0; cycle < cycles; cycle++) {
+		for (size_t line = 0; line < LINES_PER_CYCLE; line++)
+			print();
+		readBytes += read().size();
+	}
+	// Pipe capture can still be copying the last cycles
+	for (int attempt = 0; attempt < 1000 && readBytes < bytes; attempt++) {
+		std::this_thread::sleep_for(std::chrono::milliseconds { 1 });
+		readBytes += read().size();
+	}
+	double seconds = std::chrono::duration<double> {
+			std::chrono::steady_clock::now() - start }.count();
+	DoNotOptimize(readBytes);
+	return readBytes / seconds / 1e6;
+}
+
+}
+
+AKIT_BENCHMARK(ConsoleCapture) {
+	// The history copy makes each read slower than the last, so a full
+	// session would take minutes
+	for (size_t megabytes : { 1, 4 }) {
+		PreviousCapture capture;
+		std::ostream out { &capture };
+		double rate = MeasureSession(megabytes << 20, [&] {
+			out << LINE;
+		}, [&] {
+			return capture.GetNewData();
+		});
+		ReportRate("Previous capture, " + std::to_string(megabytes)
+				+ " MB session", rate, "MB");
+	}
+
+	ConsoleRingBuffer ring { SimulatorConsoleSource::CAPTURE_CAPACITY };
+	ReportRate("Ring buffer, 10 MB session", MeasureSession(SESSION_BYTES, [&] {
+		ring.Write(LINE);
+	}, [&] {
+		return ring.Read();
+	}), "MB");
+
+#ifndef _WIN32
+	// The source copies output to the original stdout, so send that to
+	// /dev/null for the session
+	std::fflush(stdout);
+	int console = dup(STDOUT_FILENO);
+	int null = open("/dev/null", O_WRONLY);
+	dup2(null, STDOUT_FILENO);
+	close(null);
+	double coutRate, printfRate;
+	{
+		SimulatorConsoleSource source;
+		coutRate = MeasureSession(SESSION_BYTES, [&] {
+			std::cout << LINE;
+		}, [&] {
+			return source.GetNewData();
+		});
+		printfRate = MeasureSession(SESSION_BYTES, [&] {
+			std::fputs(LINE.c_str(), stdout);
+		}, [&] {
+			return source.GetNewData();
+		});
+	}
+	std::fflush(stdout);
+	dup2(console, STDOUT_FILENO);
+	close(console);
+	ReportRate("SimulatorConsoleSource cout, 10 MB session", coutRate, "MB");
+	ReportRate("SimulatorConsoleSource printf, 10 MB session", printfRate,
+			"MB");
+#endif
+}
@@ -0,0 +1,214 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "Benchmark.h"
+#include "akit/LogTable.h"
+
+using namespace akit;
+using akit::bench::DoNotOptimize;
+using akit::bench::Measure;
+
+namespace {
+
+LogTable MakeTable(size_t fieldCount) {
+	LogTable table { 0_s };
+	for (size_t i = 0; i < fieldCount; i++)
+		table.Put("RealOutputs/Field" + std::to_string(i),
+				static_cast<double>(i));
+	return table;
+}
+
+}
+
+AKIT_BENCHMARK(LogTableGetSubtable) {
+	for (size_t fieldCount : { 100, 2000 }) {
+		LogTable table = MakeTable(fieldCount);
+		std::string suffix = " (" + std::to_string(fieldCount) + " fields)";
+
+		Measure("GetSubtable" + suffix, 100000, [&] {
+			DoNotOptimize(table.GetSubtable("Drive"));
+		});
+		Measure("Full table copy (previous GetSubtable)" + suffix, 1000, [&] {
+			DoNotOptimize(LogTable { table });
+		});
+	}
+}
+
+AKIT_BENCHMARK(LogTableSnapshot) {
+	constexpr size_t iterations = 2000;
+	for (size_t fieldCount : { 500, 2000, 8000 }) {
+		LogTable table = MakeTable(fieldCount);
+		std::string fields = " (" + std::to_string(fieldCount) + " fields";
+		Measure("Full copy (previous enqueue)" + fields + ")", 200, [&] {
+			DoNotOptimize(LogTable { table }.Snapshot(CycleArena::Acquire()));
+		});
+
+		for (size_t percent : { 1, 10, 100 }) {
+			for (bool scattered : { false, true }) {
+				size_t changed = std::max<size_t>(fieldCount * percent / 100, 1);
+				size_t stride = scattered ? fieldCount / changed : 1;
+				std::vector < std::string > keys;
+				for (size_t i = 0; i < changed; i++)
+					keys.push_back(
+							"RealOutputs/Field" + std::to_string(i * stride));
+
+				// Snapshots stay alive for a few cycles, as if in the queue, and
+				// only the Snapshot call itself is timed
+				std::deque<LogTable> queue;
+				std::chrono::steady_clock::duration elapsed { };
+				for (size_t cycle = 0; cycle < iterations; cycle++) {
+					for (const auto &key : keys)
+						table.Put(key, static_cast<double>(cycle));
+					auto start = std::chrono::steady_clock::now();
+					queue.push_back(table.Snapshot(CycleArena::Acquire()));
+					elapsed += std::chrono::steady_clock::now() - start;
+					if (queue.size() > 3)
+						queue.pop_front();
+				}
+
+				akit::bench::Report(
+						"Snapshot" + fields + ", " + std::to_string(percent)
+								+ "% " + (scattered ? "scattered" : "clustered")
+								+ ")",
+						std::chrono::duration<double, std::nano> { elapsed }.count()
+								/ iterations);
+			}
+		}
+	}
+}
+
+AKIT_BENCHMARK(LogTableHandle) {
+	constexpr size_t fieldCount = 200;
+	LogTable table { 0_s };
+	LogTable outputs = table.GetSubtable("RealOutputs");
+	std::vector < std::string > keys;
+	std::vector<LogTable::Handle<double>> handles;
+	for (size_t i = 0; i < fieldCount; i++) {
+		keys.push_back("Drive/Module" + std::to_string(i) + "/Velocity");
+		handles.push_back(outputs.Register<double>(keys.back()));
+	}
+
+	double value = 0;
+	Measure("Put by key (200 fields)", 5000, [&] {
+		value++;
+		for (const auto &key : keys)
+			outputs.Put(key, value);
+	});
+	Measure("Handle Set (200 fields)", 5000, [&] {
+		value++;
+		for (auto &handle : handles)
+			handle.Set(value);
+	});
+}
+
+AKIT_BENCHMARK(LogTableNestedArray) {
+	for (size_t rowCount : { 100, 500 }) {
+		std::vector<std::vector<double>> targets;
+		for (size_t i = 0; i < rowCount; i++)
+			targets.push_back( { i * 1.0, i * 2.0, i * 3.0, i * 4.0 });
+
+		LogTable table { 0_s };
+		LogTable camera = table.GetSubtable("Camera");
+		std::string suffix = " (" + std::to_string(rowCount) + " rows)";
+		double value = 0;
+
+		Measure("Put nested" + suffix, 2000, [&] {
+			targets[0][0] = value++;
+			camera.Put("Targets", targets);
+		});
+		// Previous Put: the length and every row key built per call
+		Measure("Put row by row (previous)" + suffix, 2000, [&] {
+			targets[0][0] = value++;
+			camera.Put(std::string { "Targets" } + "/length",
+					static_cast<long>(targets.size()));
+			for (size_t i = 0; i < targets.size(); i++)
+				camera.Put("Targets/" + std::to_string(i), targets[i]);
+		});
+
+		Measure("Get nested" + suffix, 2000, [&] {
+			DoNotOptimize(
+					camera.Get("Targets", std::vector<std::vector<double>> { }));
+		});
+		Measure("Get row by row (previous)" + suffix, 2000, [&] {
+			std::vector<std::vector<double>> rows(
+					camera.Get("Targets/length", 0L));
+			for (size_t i = 0; i < rows.size(); i++)
+				rows[i] = camera.Get("Targets/" + std::to_string(i),
+						std::vector<double> { });
+			DoNotOptimize(rows);
+		});
+	}
+}
+
+namespace {
+
+// Runs reads on each of threadCount threads while another thread keeps
+// updating the timestamp, and returns the mean cost per read
+template<typename F>
+double MeasureContended(size_t threadCount, size_t readsPerThread,
+		std::atomic<bool> &writing, F &&read) {
+	std::atomic<size_t> ready = 0;
+	std::vector < std::thread > threads;
+	auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < threadCount; i++)
+		threads.emplace_back([&] {
+			ready++;
+			while (ready < threadCount) {
+			}
+			for (size_t n = 0; n < readsPerThread; n++)
+				read();
+		});
+	for (auto &thread : threads)
+		thread.join();
+	auto end = std::chrono::steady_clock::now();
+	writing = false;
+	return std::chrono::duration<double, std::nano> { end - start }.count()
+			/ readsPerThread;
+}
+
+}
+
+AKIT_BENCHMARK(LogTableTimestampContention) {
+	constexpr size_t reads = 1000000;
+	LogTable table { 0_s };
+	std::mutex mutex;
+	units::second_t lockedTimestamp = 0_s;
+
+	for (size_t threadCount : { 1, 2, 4, 8 }) {
+		std::string suffix = " (" + std::to_string(threadCount)
+				+ " readers + 1 writer)";
+
+		std::atomic<bool> writing = true;
+		std::thread writer { [&] {
+			for (double time = 0; writing; time += 0.02)
+				table.SetTimestamp(units::second_t { time });
+		} };
+		akit::bench::Report("Atomic read" + suffix,
+				MeasureContended(threadCount, reads, writing, [&] {
+					DoNotOptimize(table.GetTimestamp());
+				}));
+		writer.join();
+
+		writing = true;
+		writer = std::thread { [&] {
+			for (double time = 0; writing; time += 0.02) {
+				std::lock_guard lock { mutex };
+				lockedTimestamp = units::second_t { time };
+			}
+		} };
+		akit::bench::Report("Mutex read (previous)" + suffix,
+				MeasureContended(threadCount, reads, writing, [&] {
+					std::lock_guard lock { mutex };
+					DoNotOptimize(lockedTimestamp);
+				}));
+		writer.join();
+	}
+}
@@ -0,0 +1,144 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <any>
+#include <units/length.h>
+#include "Benchmark.h"
+#include "akit/LogTable.h"
+
+using namespace akit;
+using akit::bench::DoNotOptimize;
+using akit::bench::Measure;
+
+namespace {
+
+constexpr size_t ITERATIONS = 1000000;
+
+// The std::any representation LogValue used previously, kept as a baseline
+struct LegacyLogValue {
+	LogTable::LoggableType type;
+	std::string customTypeStr;
+	std::string unitStr;
+	std::any value;
+
+	template<typename T>
+	T Get() const {
+		return std::any_cast<T>(value);
+	}
+
+	template<typename T>
+	bool Equals(const LegacyLogValue &other) const {
+		return type == other.type && customTypeStr == other.customTypeStr
+				&& unitStr == other.unitStr && Get<T>() == other.Get<T>();
+	}
+};
+
+template<typename T, typename Getter>
+void Compare(std::string_view name, LogTable::LoggableType type, T sample,
+		Getter get) {
+	std::unordered_map<std::string, LegacyLogValue> legacyTable;
+	std::unordered_map<std::string, LogTable::LogValue> table;
+	std::string key = "/RealOutputs/Drive/Module0/Value";
+
+	std::printf(" %.*s\n", static_cast<int>(name.size()), name.data());
+	Measure("Put (std::any)", ITERATIONS, [&] {
+		legacyTable.insert_or_assign(key, LegacyLogValue { type, "", "", sample });
+	});
+	Measure("Put (variant)", ITERATIONS, [&] {
+		table.insert_or_assign(key, LogTable::LogValue { sample, "" });
+	});
+
+	const LegacyLogValue &legacyValue = legacyTable.at(key);
+	const LogTable::LogValue &value = table.at(key);
+	Measure("Get (std::any)", ITERATIONS, [&] {
+		DoNotOptimize(legacyValue.Get<T>());
+	});
+	Measure("Get (variant)", ITERATIONS, [&] {
+		DoNotOptimize(get(value));
+	});
+
+	LegacyLogValue legacyOther = legacyValue;
+	LogTable::LogValue other = value;
+	Measure("operator== (std::any)", ITERATIONS, [&] {
+		DoNotOptimize(legacyValue.Equals<T>(legacyOther));
+	});
+	Measure("operator== (variant)", ITERATIONS, [&] {
+		DoNotOptimize(value == other);
+	});
+}
+
+}
+
+AKIT_BENCHMARK(LogValuePutGetEquals) {
+	using Type = LogTable::LoggableType;
+	using Value = LogTable::LogValue;
+
+	Compare("Raw", Type::Raw, std::vector<std::byte>(48),
+			[](const Value &v) { return v.GetRaw(); });
+	Compare("Boolean", Type::Boolean, true,
+			[](const Value &v) { return v.GetBoolean(); });
+	Compare("Integer", Type::Integer, 42L,
+			[](const Value &v) { return v.GetInteger(); });
+	Compare("Float", Type::Float, 1.5f,
+			[](const Value &v) { return v.GetFloat(); });
+	Compare("Double", Type::Double, 1.5,
+			[](const Value &v) { return v.GetDouble(); });
+	Compare("String", Type::String, std::string { "Autonomous" },
+			[](const Value &v) { return v.GetString(); });
+	Compare("BooleanArray", Type::BooleanArray, std::vector<bool>(12),
+			[](const Value &v) { return v.GetBooleanArray(); });
+	Compare("IntegerArray", Type::IntegerArray, std::vector<long>(12),
+			[](const Value &v) { return v.GetIntegerArray(); });
+	Compare("FloatArray", Type::FloatArray, std::vector<float>(12),
+			[](const Value &v) { return v.GetFloatArray(); });
+	Compare("DoubleArray", Type::DoubleArray, std::vector<double>(24),
+			[](const Value &v) { return v.GetDoubleArray(); });
+	Compare("StringArray", Type::StringArray,
+			std::vector<std::string> { "Left", "Right" },
+			[](const Value &v) { return v.GetStringArray(); });
+}
+
+AKIT_BENCHMARK(LogValueUnits) {
+	constexpr size_t fieldCount = 400;
+	std::printf("  sizeof(LogValue) = %zu, previous std::any value = %zu\n",
+			sizeof(LogTable::LogValue), sizeof(LegacyLogValue));
+
+	std::vector<LegacyLogValue> legacyValues;
+	std::vector<LogTable::LogValue> values;
+	for (size_t i = 0; i < fieldCount; i++) {
+		legacyValues.push_back(LegacyLogValue { LogTable::LoggableType::Double,
+				"", "meters_per_second", static_cast<double>(i) });
+		values.push_back(LogTable::LogValue { static_cast<double>(i), "",
+				"meters_per_second" });
+	}
+	std::vector<LegacyLogValue> legacyCopies = legacyValues;
+	std::vector<LogTable::LogValue> copies = values;
+
+	Measure("Compare 400 unit fields (strings)", 10000, [&] {
+		size_t equal = 0;
+		for (size_t i = 0; i < fieldCount; i++)
+			equal += legacyValues[i].Equals<double>(legacyCopies[i]);
+		DoNotOptimize(equal);
+	});
+	Measure("Compare 400 unit fields (interned)", 10000, [&] {
+		size_t equal = 0;
+		for (size_t i = 0; i < fieldCount; i++)
+			equal += values[i] == copies[i];
+		DoNotOptimize(equal);
+	});
+
+	LogTable table { 0_s };
+	std::vector < std::string > keys;
+	for (size_t i = 0; i < fieldCount; i++)
+		keys.push_back("Drive/Module" + std::to_string(i) + "/Position");
+	double position = 0;
+	Measure("Put 400 unit fields", 5000, [&] {
+		position++;
+		for (const auto &key : keys)
+			table.Put(key, units::meter_t { position });
+	});
+}
@@ -0,0 +1,52 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include "Benchmark.h"
+#include "akit/Profiler.h"
+
+using namespace akit;
+using akit::bench::Measure;
+
+AKIT_BENCHMARK(ProfilerSpan) {
+	LogTable table { 0_s };
+	size_t spansSinceFlush = 0;
+	auto flushIfFull = [&] {
+		// Stay within the ring so no records are overwritten
+		if (++spansSinceFlush == Profiler::RING_CAPACITY / 2) {
+			Profiler::Flush(table.GetSubtable("Profiling"));
+			spansSinceFlush = 0;
+		}
+	};
+
+	Measure("AKIT_PROFILE span", 1000000, [&] {
+		AKIT_PROFILE("Bench/Span");
+		flushIfFull();
+	});
+	Measure("Nested AKIT_PROFILE spans (x2)", 1000000, [&] {
+		AKIT_PROFILE("Bench/Outer");
+		{
+			AKIT_PROFILE("Bench/Outer/Inner");
+		}
+		flushIfFull();
+		flushIfFull();
+	});
+	// Previous approach: two FPGA timestamp reads per section, approximated
+	// here with the same clock the spans use
+	Measure("Two clock reads (previous, lower bound)", 1000000, [&] {
+		akit::bench::DoNotOptimize(
+				Profiler::Clock::now() - Profiler::Clock::now());
+	});
+
+	std::vector<Profiler::SpanId> ids;
+	for (int i = 0; i < 30; i++)
+		ids.push_back(Profiler::RegisterSpan("Bench/Flush" + std::to_string(i)));
+	Measure("Flush, 30 spans", 2000, [&] {
+		for (Profiler::SpanId id : ids)
+			Profiler::Span { id };
+		Profiler::Flush(table.GetSubtable("Profiling"));
+	});
+}
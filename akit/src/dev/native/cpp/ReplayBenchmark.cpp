@@ -0,0 +1,103 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "akit/PipelinedReplaySource.h"
+#include "akit/ReceiverThread.h"
+
+using namespace akit;
+using akit::bench::DoNotOptimize;
+using akit::bench::Measure;
+using akit::bench::ReportRate;
+
+namespace {
+
+constexpr size_t FIELD_COUNT = 200;
+constexpr size_t CYCLE_COUNT = 20000;
+
+// Builds each cycle by key, as WPILOGReader does while decoding records
+class SyntheticSource: public LogReplaySource {
+public:
+	SyntheticSource() {
+		for (size_t i = 0; i < FIELD_COUNT; i++)
+			keys.push_back("Drive/Module" + std::to_string(i / 10) + "/Field"
+					+ std::to_string(i % 10));
+	}
+
+	void Start() override {
+	}
+
+	bool UpdateTable(LogTable &table) override {
+		cycle++;
+		table.SetTimestamp(units::second_t { cycle * 0.02 });
+		for (size_t i = 0; i < keys.size(); i++)
+			table.Put(keys[i], cycle * 0.5 + i);
+		return true;
+	}
+
+private:
+	std::vector<std::string> keys;
+	int64_t cycle = 0;
+};
+
+// Visits every changed field, standing in for a log writer
+class EncodingReceiver: public LogDataReceiver {
+public:
+	void Start() override {
+	}
+
+	void End() override {
+	}
+
+	void PutTable(LogTable &table) override {
+		double sum = 0;
+		table.ForEachChange(lastRevision,
+				[&](KeyRegistry::FieldId, const LogTable::LogValue &value) {
+					sum += value.GetDouble();
+				});
+		lastRevision = table.GetRevision();
+		DoNotOptimize(sum);
+	}
+
+private:
+	uint64_t lastRevision = 0;
+};
+
+// Runs replay cycles the way Logger does: update the entry, run user code
+// that reads inputs and writes outputs, then queue the cycle for the writer
+void MeasureReplay(std::string_view label, LogReplaySource &source) {
+	LogTable entry { 0_s };
+	LogTable inputs = entry.GetSubtable("Drive");
+	LogTable outputs = entry.GetSubtable("ReplayOutputs");
+	ReceiverThread receivers { 16 };
+	receivers.AddDataReceiver(std::make_unique<EncodingReceiver>());
+	receivers.SetPolicy(ReceiverQueue::Policy::BLOCK);
+	receivers.Start();
+	source.Start();
+
+	double nsPerCycle = Measure(label, CYCLE_COUNT, [&] {
+		source.UpdateTable(entry);
+		for (int i = 0; i < 20; i++)
+			outputs.Put("Module" + std::to_string(i) + "/Setpoint",
+					inputs.Get("Module" + std::to_string(i) + "/Field0", 0.0));
+		receivers.PutTable(entry.Snapshot(CycleArena::Acquire()));
+	});
+	ReportRate(label, 1e9 / nsPerCycle, "cycles");
+}
+
+}
+
+AKIT_BENCHMARK(ReplayThroughput) {
+	SyntheticSource direct;
+	MeasureReplay("Synchronous replay", direct);
+
+	PipelinedReplaySource pipelined { std::make_unique<SyntheticSource>() };
+	MeasureReplay("Pipelined replay", pipelined);
+}
@@ -0,0 +1,74 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <chrono>
+#include "Benchmark.h"
+#include "akit/PeriodicScheduler.h"
+
+using namespace akit;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr size_t CYCLES = 1000;
+
+void BusyWait(std::chrono::microseconds duration) {
+	auto end = std::chrono::steady_clock::now() + duration;
+	while (std::chrono::steady_clock::now() < end) {
+	}
+}
+
+struct TaskSpec {
+	size_t period;
+	std::chrono::microseconds cost;
+};
+
+// Four 10-cycle tasks and four 50-cycle tasks of varying cost
+const std::vector<TaskSpec> TASKS = { { 10, 50us }, { 10, 50us }, { 10, 100us },
+		{ 10, 200us }, { 50, 100us }, { 50, 200us }, { 50, 400us }, { 50, 400us } };
+
+// Returns the longest cycle, in nanoseconds
+template<typename F>
+double MeasureWorstCycle(F &&runCycle) {
+	double worst = 0;
+	for (size_t cycle = 0; cycle < CYCLES; cycle++) {
+		auto start = std::chrono::steady_clock::now();
+		runCycle(cycle);
+		worst = std::max(worst, std::chrono::duration<double, std::nano> {
+				std::chrono::steady_clock::now() - start }.count());
+	}
+	return worst;
+}
+
+}
+
+AKIT_BENCHMARK(SchedulerWorstCycle) {
+	// Previous RunEveryN behaviour: every task runs when cycle % n == 0
+	akit::bench::Report("Worst cycle, aligned (RunEveryN)",
+			MeasureWorstCycle([](size_t cycle) {
+				for (const TaskSpec &task : TASKS) {
+					if (cycle % task.period == 0)
+						BusyWait(task.cost);
+				}
+			}));
+
+	PeriodicScheduler scheduler;
+	for (size_t i = 0; i < TASKS.size(); i++) {
+		auto cost = TASKS[i].cost;
+		scheduler.Add("Bench" + std::to_string(i), TASKS[i].period, [cost] {
+			BusyWait(cost);
+		});
+	}
+	// Measure costs, then balance by them
+	for (size_t cycle = 0; cycle < 50; cycle++)
+		scheduler.Run();
+	scheduler.Rebalance();
+	akit::bench::Report("Worst cycle, PeriodicScheduler",
+			MeasureWorstCycle([&](size_t) {
+				scheduler.Run();
+			}));
+}
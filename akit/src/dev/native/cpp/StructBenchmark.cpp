@@ -0,0 +1,117 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <unordered_set>
+#include <frc/geometry/Pose2d.h>
+#include <frc/kinematics/SwerveModuleState.h>
+
+#include "Benchmark.h"
+#include "akit/LogTable.h"
+
+using namespace akit;
+using akit::bench::Measure;
+
+namespace {
+
+// The per-Put work of the previous AddStructSchema, without the schema
+// write itself (which only ever happened once)
+template<typename T>
+void LegacySchemaCheck(LogTable &table) {
+	std::string typeString = wpi::GetStructTypeString<T>();
+	KeyRegistry::FieldId id = KeyRegistry::GetId("/.schema/" + typeString);
+	std::unordered_set < std::string > seen;
+	seen.insert(typeString);
+	akit::bench::DoNotOptimize(table.Find(id));
+}
+
+}
+
+AKIT_BENCHMARK(LogTableStructPut) {
+	constexpr size_t count = 25;
+	std::vector < std::string > poseKeys, stateKeys;
+	for (size_t i = 0; i < count; i++) {
+		poseKeys.push_back("Poses/Pose" + std::to_string(i));
+		stateKeys.push_back("States/State" + std::to_string(i));
+	}
+
+	LogTable table { 0_s };
+	double value = 0;
+	auto putAll = [&] {
+		value++;
+		for (size_t i = 0; i < count; i++) {
+			table.Put(poseKeys[i], frc::Pose2d { units::meter_t { value },
+					units::meter_t { static_cast<double>(i) },
+					frc::Rotation2d { units::radian_t { value } } });
+			table.Put(stateKeys[i], frc::SwerveModuleState {
+					units::meters_per_second_t { value }, frc::Rotation2d {
+							units::radian_t { static_cast<double>(i) } } });
+		}
+	};
+
+	Measure("50 struct Puts", 20000, putAll);
+	Measure("50 struct Puts + previous schema checks", 20000, [&] {
+		for (size_t i = 0; i < count; i++) {
+			LegacySchemaCheck<frc::Pose2d>(table);
+			LegacySchemaCheck<frc::SwerveModuleState>(table);
+		}
+		putAll();
+	});
+}
+
+AKIT_BENCHMARK(LogTableStructArray) {
+	for (size_t length : { 500, 5000 }) {
+		std::vector<frc::Pose2d> trajectory;
+		for (size_t i = 0; i < length; i++)
+			trajectory.emplace_back(units::meter_t { i * 0.01 },
+					units::meter_t { i * 0.02 }, frc::Rotation2d {
+							units::radian_t { i * 0.001 } });
+
+		LogTable table { 0_s };
+		std::string suffix = " (" + std::to_string(length) + " poses)";
+		double offset = 0;
+		Measure("Put vector" + suffix, 2000, [&] {
+			trajectory[0] = frc::Pose2d { units::meter_t { offset++ },
+					units::meter_t { 0 }, frc::Rotation2d { } };
+			table.Put("Trajectory", trajectory);
+		});
+		// Previous initializer_list path: a fresh buffer and type string
+		// per Put, packing one element at a time
+		Measure("Put element by element (previous)" + suffix, 2000, [&] {
+			trajectory[0] = frc::Pose2d { units::meter_t { offset++ },
+					units::meter_t { 0 }, frc::Rotation2d { } };
+			constexpr size_t size = wpi::GetStructSize<frc::Pose2d>();
+			std::vector<uint8_t> buffer(trajectory.size() * size);
+			for (size_t i = 0; i < trajectory.size(); i++) {
+				frc::Pose2d element = trajectory[i];
+				wpi::PackStruct(std::span { buffer }.subspan(i * size, size),
+						element);
+			}
+			table.Put("Trajectory", LogTable::LogValue { std::as_bytes(
+					std::span { buffer }), wpi::GetStructTypeString<
+					frc::Pose2d>() + "[]" });
+		});
+
+		Measure("Get vector" + suffix, 2000, [&] {
+			akit::bench::DoNotOptimize(
+					table.Get("Trajectory", std::vector<frc::Pose2d> { }));
+		});
+		// Previous Get: a copy of the raw buffer, then one unpack per element
+		// into a default-constructed vector
+		Measure("Get element by element (previous)" + suffix, 2000, [&] {
+			constexpr size_t size = wpi::GetStructSize<frc::Pose2d>();
+			std::vector<std::byte> raw = table.Get("Trajectory",
+					std::vector<std::byte> { });
+			std::vector<frc::Pose2d> structs(raw.size() / size);
+			for (size_t i = 0; i < structs.size(); i++)
+				wpi::UnpackStructInto(structs.data() + i,
+						std::span<const uint8_t> {
+								reinterpret_cast<const uint8_t*>(raw.data())
+										+ i * size, size });
+			akit::bench::DoNotOptimize(structs);
+		});
+	}
+}
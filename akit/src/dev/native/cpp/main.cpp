@@ -0,0 +1,23 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <cstdio>
+#include <string_view>
+#include "Benchmark.h"
+
+// Runs every registered benchmark, or only those whose names contain the
+// first argument
+int main(int argc, char **argv) {
+	std::string_view filter = argc > 1 ? argv[1] : "";
+	for (const auto &benchmark : akit::bench::GetRegistry()) {
+		if (!filter.empty() && benchmark.name.find(filter) == std::string::npos)
+			continue;
+		std::printf("%s\n", benchmark.name.c_str());
+		benchmark.function();
+	}
+	return 0;
+}
@@ -0,0 +1,76 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace akit::bench {
+
+struct Registration {
+	std::string name;
+	std::function<void()> function;
+};
+
+inline std::vector<Registration>& GetRegistry() {
+	static std::vector<Registration> registry;
+	return registry;
+}
+
+inline bool Register(std::string name, std::function<void()> function) {
+	GetRegistry().emplace_back(std::move(name), std::move(function));
+	return true;
+}
+
+// Keeps the compiler from discarding a value computed inside a benchmark
+template<typename T>
+inline void DoNotOptimize(const T &value) {
+	static volatile const void *sink;
+	sink = &value;
+	std::atomic_signal_fence(std::memory_order_seq_cst);
+}
+
+inline void Report(std::string_view label, double nsPerOp) {
+	std::printf("  %-48.*s %12.1f ns/op\n", static_cast<int>(label.size()),
+			label.data(), nsPerOp);
+}
+
+inline void ReportRate(std::string_view label, double perSecond,
+		std::string_view unit) {
+	std::printf("  %-48.*s %12.0f %.*s/s\n", static_cast<int>(label.size()),
+			label.data(), perSecond, static_cast<int>(unit.size()),
+			unit.data());
+}
+
+// Runs op the given number of times and prints the mean cost per call
+template<typename F>
+double Measure(std::string_view label, size_t iterations, F &&op) {
+	for (size_t i = 0; i < iterations / 10 + 1; i++)
+		op();
+
+	auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < iterations; i++)
+		op();
+	auto end = std::chrono::steady_clock::now();
+
+	double nsPerOp = std::chrono::duration<double, std::nano> { end - start }.count()
+			/ iterations;
+	Report(label, nsPerOp);
+	return nsPerOp;
+}
+
+}
+
+#define AKIT_BENCHMARK(name) \
+	static void name(); \
+	static const bool name##Registered = ::akit::bench::Register(#name, name); \
+	static void name()
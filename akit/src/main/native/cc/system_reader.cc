@@ -51,7 +51,7 @@ void SystemReader::read(schema::SystemData *system_buf) {
 	system_buf->mutate_browned_out(HAL_GetBrownedOut(&status));
 	system_buf->mutate_comms_disable_count(HAL_GetCommsDisableCount(&status));
 	system_buf->mutate_rsl_state(HAL_GetRSLState(&status));
-	if (cycleCount % 50 == 0) {
+	if (cycleCount % SYSTEM_TIME_PERIOD == SYSTEM_TIME_PHASE) {
 		// This read takes longer
 		system_buf->mutate_system_time_valid(HAL_GetSystemTimeValid(&status));
 	}
@@ -80,7 +80,7 @@ void SystemReader::read(schema::SystemData *system_buf) {
 	system_buf->mutate_brownout_voltage(HAL_GetBrownoutVoltage(&status));
 	system_buf->mutate_cpu_temp(HAL_GetCPUTemp(&status));
 
-	if (cycleCount % 20 == 0) {
+	if (cycleCount % CAN_STATUS_PERIOD == CAN_STATUS_PHASE) {
 		float percent_bus_utilization = 0;
 		uint32_t bus_off_count = 0;
 		uint32_t tx_full_count = 0;
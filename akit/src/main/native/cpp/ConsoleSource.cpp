@@ -5,43 +5,245 @@
 // license that can be found in the LICENSE file
 // at the root directory of this project.
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <frc/Errors.h>
 #include <vector>
 #include "akit/ConsoleSource.h"
 
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
 using namespace akit;
 
-SimulatorConsoleSource::SimulatorConsoleSource() : originalCout {
-		std::cout.rdbuf(&splitCout) }, originalCerr { std::cerr.rdbuf(
-		&splitCerr) } {
+void ConsoleRingBuffer::Write(std::string_view data) {
+	std::lock_guard lock { mutex };
+	size_t capacity = buffer.size();
+	if (data.size() >= capacity) {
+		dropped += size + data.size() - capacity;
+		data = data.substr(data.size() - capacity);
+		start = 0;
+		size = 0;
+	} else if (size + data.size() > capacity) {
+		size_t overflow = size + data.size() - capacity;
+		start = (start + overflow) % capacity;
+		size -= overflow;
+		dropped += overflow;
+	}
+
+	size_t end = (start + size) % capacity;
+	size_t first = std::min(data.size(), capacity - end);
+	std::memcpy(buffer.data() + end, data.data(), first);
+	std::memcpy(buffer.data(), data.data() + first, data.size() - first);
+	size += data.size();
 }
 
-SimulatorConsoleSource::~SimulatorConsoleSource() {
-	std::cout.rdbuf(originalCout);
-	std::cerr.rdbuf(originalCerr);
+std::string ConsoleRingBuffer::Read(size_t *droppedBytes) {
+	std::lock_guard lock { mutex };
+	std::string result;
+	size_t first = std::min(size, buffer.size() - start);
+	result.reserve(size);
+	result.append(buffer.data() + start, first);
+	result.append(buffer.data(), size - first);
+	start = 0;
+	size = 0;
+	if (droppedBytes)
+		*droppedBytes = dropped;
+	dropped = 0;
+	return result;
 }
 
-std::string SimulatorConsoleSource::GetNewData() {
-	std::string fullOut = capturedCout.str();
-	std::string newOut = fullOut.substr(coutPos);
-	coutPos = fullOut.size();
+SimulatorConsoleSource::SimulatorConsoleSource() {
+	if (StartPipeCapture())
+		return;
+	originalCout = std::cout.rdbuf();
+	originalCerr = std::cerr.rdbuf();
+	splitCout = std::make_unique < SplitBuffer > (originalCout, captured);
+	splitCerr = std::make_unique < SplitBuffer > (originalCerr, captured);
+	std::cout.rdbuf(splitCout.get());
+	std::cerr.rdbuf(splitCerr.get());
+}
 
-	std::string fullErr = capturedCerr.str();
-	std::string newErr = fullErr.substr(coutPos);
-	cerrPos = fullErr.size();
+SimulatorConsoleSource::~SimulatorConsoleSource() {
+	if (reader.joinable()) {
+		StopPipeCapture();
+	} else {
+		std::cout.rdbuf(originalCout);
+		std::cerr.rdbuf(originalCerr);
+	}
+}
 
-	return newOut + newErr;
+std::string SimulatorConsoleSource::GetNewData() {
+	size_t dropped;
+	std::string data = captured.Read(&dropped);
+	if (dropped > 0)
+		return "[AdvantageKit] " + std::to_string(dropped)
+				+ " bytes of console output were dropped\n" + data;
+	return data;
 }
 
 int SimulatorConsoleSource::SplitBuffer::overflow(int c) {
 	if (c == EOF)
 		return !EOF;
-	original->sputc(c);
-	capture.put(static_cast<char>(c));
+	char ch = static_cast<char>(c);
+	original->sputc(ch);
+	capture.Write(std::string_view { &ch, 1 });
 	return c;
 }
 
+std::streamsize SimulatorConsoleSource::SplitBuffer::xsputn(const char *s,
+		std::streamsize n) {
+	original->sputn(s, n);
+	capture.Write(std::string_view { s, static_cast<size_t>(n) });
+	return n;
+}
+
+int SimulatorConsoleSource::SplitBuffer::sync() {
+	return original->pubsync();
+}
+
+#ifdef _WIN32
+
+bool SimulatorConsoleSource::StartPipeCapture() {
+	return false;
+}
+
+void SimulatorConsoleSource::StopPipeCapture() {
+}
+
+void SimulatorConsoleSource::ReadPipe() {
+}
+
+#else
+
+namespace {
+
+constexpr std::array<int, 2> STREAM_FDS { STDOUT_FILENO, STDERR_FILENO };
+
+void FlushStreams() {
+	std::cout.flush();
+	std::cerr.flush();
+	std::fflush(stdout);
+	std::fflush(stderr);
+}
+
+void WriteAll(int fd, const char *data, size_t size) {
+	while (size > 0) {
+		ssize_t written = write(fd, data, size);
+		if (written < 0) {
+			if (errno == EINTR)
+				continue;
+			return;
+		}
+		data += written;
+		size -= written;
+	}
+}
+
+}
+
+bool SimulatorConsoleSource::StartPipeCapture() {
+	std::array<int, 2> pipeWrites { -1, -1 };
+	auto closeAll = [&] {
+		for (size_t i = 0; i < 2; i++) {
+			if (pipeReads[i] >= 0)
+				close(pipeReads[i]);
+			if (pipeWrites[i] >= 0)
+				close(pipeWrites[i]);
+			if (originalFds[i] >= 0)
+				close(originalFds[i]);
+			pipeReads[i] = pipeWrites[i] = originalFds[i] = -1;
+		}
+	};
+
+	for (size_t i = 0; i < 2; i++) {
+		int fds[2];
+		if (pipe(fds) != 0) {
+			closeAll();
+			return false;
+		}
+		pipeReads[i] = fds[0];
+		pipeWrites[i] = fds[1];
+		originalFds[i] = dup(STREAM_FDS[i]);
+		if (originalFds[i] < 0) {
+			closeAll();
+			return false;
+		}
+		// Not inherited by child processes, which would hold the pipes open
+		fcntl(pipeReads[i], F_SETFD, FD_CLOEXEC);
+		fcntl(originalFds[i], F_SETFD, FD_CLOEXEC);
+	}
+
+	FlushStreams();
+	for (size_t i = 0; i < 2; i++) {
+		if (dup2(pipeWrites[i], STREAM_FDS[i]) < 0) {
+			for (size_t j = 0; j < i; j++)
+				dup2(originalFds[j], STREAM_FDS[j]);
+			closeAll();
+			return false;
+		}
+		close(pipeWrites[i]);
+		pipeWrites[i] = -1;
+	}
+	// stdout is fully buffered when it is a pipe, which would hold printf
+	// output back from both the console and the log
+	std::setvbuf(stdout, nullptr, _IOLBF, BUFSIZ);
+
+	reading = true;
+	reader = std::thread { &SimulatorConsoleSource::ReadPipe, this };
+	return true;
+}
+
+void SimulatorConsoleSource::StopPipeCapture() {
+	// Restoring the streams closes the pipes' write ends, so the reader
+	// copies what is left and sees the end of each pipe
+	FlushStreams();
+	for (size_t i = 0; i < 2; i++)
+		dup2(originalFds[i], STREAM_FDS[i]);
+	reading = false;
+	reader.join();
+	for (size_t i = 0; i < 2; i++) {
+		close(pipeReads[i]);
+		close(originalFds[i]);
+	}
+}
+
+void SimulatorConsoleSource::ReadPipe() {
+	std::array<pollfd, 2> fds;
+	for (size_t i = 0; i < 2; i++)
+		fds[i] = pollfd { pipeReads[i], POLLIN, 0 };
+	char chunk[4096];
+
+	while (fds[0].fd >= 0 || fds[1].fd >= 0) {
+		// The timeout ends reading if a child process still holds a pipe
+		int ready = poll(fds.data(), fds.size(), 50);
+		if (ready < 0 && errno != EINTR)
+			return;
+		if (ready == 0 && !reading)
+			return;
+		for (size_t i = 0; i < 2; i++) {
+			if (fds[i].fd < 0 || fds[i].revents == 0)
+				continue;
+			ssize_t length = read(fds[i].fd, chunk, sizeof(chunk));
+			if (length <= 0) {
+				if (length == 0 || errno != EINTR)
+					fds[i].fd = -1;
+				continue;
+			}
+			WriteAll(originalFds[i], chunk, length);
+			captured.Write(std::string_view { chunk, static_cast<size_t>(length) });
+		}
+	}
+}
+
+#endif
+
 RoboRIOConsoleSource::~RoboRIOConsoleSource() {
 	running = false;
 	thread.join();
@@ -0,0 +1,69 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <algorithm>
+#include <bit>
+#include "akit/CycleArena.h"
+
+using namespace akit;
+
+std::mutex CycleArena::poolMutex;
+std::vector<std::unique_ptr<CycleArena>> CycleArena::idleArenas;
+CycleArena::PoolStats CycleArena::stats;
+
+CycleArena::CycleArena() : buffer(INITIAL_BUFFER_SIZE) {
+	Reset();
+}
+
+std::shared_ptr<CycleArena> CycleArena::Acquire() {
+	std::unique_ptr<CycleArena> arena;
+	{
+		std::lock_guard lock { poolMutex };
+		if (!idleArenas.empty()) {
+			arena = std::move(idleArenas.back());
+			idleArenas.pop_back();
+		} else
+			stats.totalArenas++;
+	}
+	if (!arena)
+		arena.reset(new CycleArena());
+	return std::shared_ptr<CycleArena> { arena.release(), [](
+			CycleArena *arena) {
+		arena->Recycle();
+	} };
+}
+
+CycleArena::PoolStats CycleArena::GetPoolStats() {
+	std::lock_guard lock { poolMutex };
+	PoolStats current = stats;
+	current.idleArenas = idleArenas.size();
+	return current;
+}
+
+void* CycleArena::do_allocate(size_t bytes, size_t alignment) {
+	bytesAllocated += bytes;
+	return resource->allocate(bytes, alignment);
+}
+
+void CycleArena::Reset() {
+	resource.reset();
+	if (bytesAllocated > buffer.size())
+		buffer.resize(std::bit_ceil(bytesAllocated));
+	resource.emplace(buffer.data(), buffer.size(),
+			std::pmr::new_delete_resource());
+	bytesAllocated = 0;
+}
+
+void CycleArena::Recycle() {
+	size_t cycleBytes = bytesAllocated;
+	Reset();
+
+	std::lock_guard lock { poolMutex };
+	stats.lastCycleBytes = cycleBytes;
+	stats.highWaterBytes = std::max(stats.highWaterBytes, cycleBytes);
+	idleArenas.emplace_back(this);
+}
@@ -0,0 +1,48 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <mutex>
+#include "akit/KeyRegistry.h"
+
+using namespace akit;
+
+std::shared_mutex KeyRegistry::mutex;
+std::unordered_map<std::string, KeyRegistry::FieldId, KeyRegistry::KeyHash,
+		std::equal_to<>> KeyRegistry::ids;
+std::deque<std::string> KeyRegistry::keys;
+
+KeyRegistry::FieldId KeyRegistry::GetId(std::string_view key) {
+	if (auto id = FindId(key))
+		return *id;
+
+	std::unique_lock lock { mutex };
+	auto existing = ids.find(key);
+	if (existing != ids.end())
+		return existing->second;
+	FieldId id = static_cast<FieldId>(keys.size());
+	keys.emplace_back(key);
+	ids.emplace(keys.back(), id);
+	return id;
+}
+
+std::optional<KeyRegistry::FieldId> KeyRegistry::FindId(std::string_view key) {
+	std::shared_lock lock { mutex };
+	auto existing = ids.find(key);
+	if (existing == ids.end())
+		return std::nullopt;
+	return existing->second;
+}
+
+const std::string& KeyRegistry::GetKey(FieldId id) {
+	std::shared_lock lock { mutex };
+	return keys.at(id);
+}
+
+size_t KeyRegistry::Size() {
+	std::shared_lock lock { mutex };
+	return keys.size();
+}
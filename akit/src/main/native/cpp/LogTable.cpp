@@ -9,275 +9,426 @@
 
 using namespace akit;
 
-LogTable::LogValue::LogValue(std::vector<std::byte> value, std::string typeStr) : type {
-		LoggableType::String }, customTypeStr { typeStr }, value { value } {
-}
-LogTable::LogValue::LogValue(bool value, std::string typeStr) : type {
-		LoggableType::Boolean }, customTypeStr { typeStr }, value { value } {
-}
-LogTable::LogValue::LogValue(long value, std::string typeStr) : type {
-		LoggableType::Integer }, customTypeStr { typeStr }, value { value } {
-}
-LogTable::LogValue::LogValue(float value, std::string typeStr,
-		std::string unitStr) : type { LoggableType::Float }, customTypeStr {
-		typeStr }, unitStr { unitStr }, value { value } {
-}
-LogTable::LogValue::LogValue(double value, std::string typeStr,
-		std::string unitStr) : type { LoggableType::Double }, customTypeStr {
-		typeStr }, unitStr { unitStr }, value { value } {
-}
-LogTable::LogValue::LogValue(std::string value, std::string typeStr) : type {
-		LoggableType::String }, customTypeStr { typeStr }, value { value } {
-}
-LogTable::LogValue::LogValue(std::vector<bool> value, std::string typeStr) : type {
-		LoggableType::BooleanArray }, customTypeStr { typeStr }, value { value } {
-}
-LogTable::LogValue::LogValue(std::vector<long> value, std::string typeStr) : type {
-		LoggableType::IntegerArray }, customTypeStr { typeStr }, value { value } {
-}
-LogTable::LogValue::LogValue(std::vector<float> value, std::string typeStr) : type {
-		LoggableType::FloatArray }, customTypeStr { typeStr }, value { value } {
-}
-LogTable::LogValue::LogValue(std::vector<double> value, std::string typeStr) : type {
-		LoggableType::DoubleArray }, customTypeStr { typeStr }, value { value } {
+LogTable::LogValue::LogValue(std::span<const std::byte> value,
+		std::string_view typeStr) : type {
+		LoggableType::Raw }, customType { StringRegistry::GetId(typeStr) }, value {
+		std::in_place_type<std::pmr::vector<std::byte>>, value.begin(),
+		value.end() } {
+}
+LogTable::LogValue::LogValue(bool value, std::string_view typeStr) : type {
+		LoggableType::Boolean }, customType { StringRegistry::GetId(typeStr) }, value {
+		value } {
+}
+LogTable::LogValue::LogValue(long value, std::string_view typeStr) : type {
+		LoggableType::Integer }, customType { StringRegistry::GetId(typeStr) }, value {
+		value } {
+}
+LogTable::LogValue::LogValue(float value, std::string_view typeStr,
+		std::string_view unitStr) : type { LoggableType::Float }, customType {
+		StringRegistry::GetId(typeStr) }, unit {
+		StringRegistry::GetId(unitStr) }, value { value } {
+}
+LogTable::LogValue::LogValue(double value, std::string_view typeStr,
+		std::string_view unitStr) : type { LoggableType::Double }, customType {
+		StringRegistry::GetId(typeStr) }, unit {
+		StringRegistry::GetId(unitStr) }, value { value } {
+}
+LogTable::LogValue::LogValue(std::string value, std::string_view typeStr) : type {
+		LoggableType::String }, customType { StringRegistry::GetId(typeStr) }, value {
+		std::in_place_type<std::pmr::string>, value } {
+}
+LogTable::LogValue::LogValue(std::vector<bool> value, std::string_view typeStr) : type {
+		LoggableType::BooleanArray }, customType { StringRegistry::GetId(typeStr) }, value {
+		std::in_place_type<std::pmr::vector<bool>>, value.begin(), value.end() } {
+}
+LogTable::LogValue::LogValue(std::vector<long> value, std::string_view typeStr) : type {
+		LoggableType::IntegerArray }, customType { StringRegistry::GetId(typeStr) }, value {
+		std::in_place_type<std::pmr::vector<long>>, value.begin(), value.end() } {
+}
+LogTable::LogValue::LogValue(std::vector<float> value, std::string_view typeStr) : type {
+		LoggableType::FloatArray }, customType { StringRegistry::GetId(typeStr) }, value {
+		std::in_place_type<std::pmr::vector<float>>, value.begin(), value.end() } {
+}
+LogTable::LogValue::LogValue(std::vector<double> value, std::string_view typeStr) : type {
+		LoggableType::DoubleArray }, customType { StringRegistry::GetId(typeStr) }, value {
+		std::in_place_type<std::pmr::vector<double>>, value.begin(), value.end() } {
 }
 LogTable::LogValue::LogValue(std::vector<std::string> value,
-		std::string typeStr) : type { LoggableType::StringArray }, customTypeStr {
-		typeStr }, value { value } {
+		std::string_view typeStr) : type { LoggableType::StringArray }, customType {
+		StringRegistry::GetId(typeStr) }, value {
+		std::in_place_type<std::pmr::vector<std::pmr::string>>, value.begin(),
+		value.end() } {
+}
+
+LogTable::LogValue::LogValue(const LogValue &other,
+		std::pmr::memory_resource *resource) : type { other.type }, customType {
+		other.customType }, unit { other.unit }, value {
+		std::visit([resource](const auto &value) -> Payload {
+			using T = std::decay_t<decltype(value)>;
+			if constexpr (std::uses_allocator_v<T,
+					std::pmr::polymorphic_allocator<>>)
+				return Payload { std::in_place_type<T>, value, resource };
+			else
+				return Payload { std::in_place_type<T>, value };
+		}, other.value) } {
 }
 
 std::vector<std::byte> LogTable::LogValue::GetRaw(
 		std::vector<std::byte> defaultValue) const {
-	return type == LoggableType::Raw ?
-			std::any_cast < std::vector < std::byte >> (value) : defaultValue;
+	auto raw = std::get_if<std::pmr::vector<std::byte>>(&value);
+	return raw ? std::vector<std::byte> { raw->begin(), raw->end() } : defaultValue;
+}
+
+std::span<const std::byte> LogTable::LogValue::GetRawView() const {
+	auto raw = std::get_if<std::pmr::vector<std::byte>>(&value);
+	return raw ? std::span<const std::byte> { *raw } : std::span<
+							const std::byte> { };
 }
 
 bool LogTable::LogValue::GetBoolean(bool defaultValue) const {
-	return type == LoggableType::Boolean ?
-			std::any_cast<bool>(value) : defaultValue;
+	auto boolean = std::get_if<bool>(&value);
+	return boolean ? *boolean : defaultValue;
 }
 
 long LogTable::LogValue::GetInteger(long defaultValue) const {
-	return type == LoggableType::Integer ?
-			std::any_cast<long>(value) : defaultValue;
+	auto integer = std::get_if<long>(&value);
+	return integer ? *integer : defaultValue;
 }
 
 float LogTable::LogValue::GetFloat(float defaultValue) const {
-	return type == LoggableType::Float ?
-			std::any_cast<float>(value) : defaultValue;
+	auto floatValue = std::get_if<float>(&value);
+	return floatValue ? *floatValue : defaultValue;
 }
 
 double LogTable::LogValue::GetDouble(double defaultValue) const {
-	return type == LoggableType::Double ?
-			std::any_cast<double>(value) : defaultValue;
+	auto doubleValue = std::get_if<double>(&value);
+	return doubleValue ? *doubleValue : defaultValue;
 }
 
 std::string LogTable::LogValue::GetString(std::string defaultValue) const {
-	return type == LoggableType::String ?
-			std::any_cast < std::string > (value) : defaultValue;
+	auto string = std::get_if<std::pmr::string>(&value);
+	return string ? std::string { *string } : defaultValue;
 }
 
 std::vector<bool> LogTable::LogValue::GetBooleanArray(
 		std::vector<bool> defaultValue) const {
-	return type == LoggableType::BooleanArray ?
-			std::any_cast<std::vector<bool>>(value) : defaultValue;
+	auto array = std::get_if<std::pmr::vector<bool>>(&value);
+	return array ? std::vector<bool> { array->begin(), array->end() } : defaultValue;
 }
 
 std::vector<long> LogTable::LogValue::GetIntegerArray(
 		std::vector<long> defaultValue) const {
-	return type == LoggableType::IntegerArray ?
-			std::any_cast<std::vector<long>>(value) : defaultValue;
+	auto array = std::get_if<std::pmr::vector<long>>(&value);
+	return array ? std::vector<long> { array->begin(), array->end() } : defaultValue;
 }
 
 std::vector<float> LogTable::LogValue::GetFloatArray(
 		std::vector<float> defaultValue) const {
-	return type == LoggableType::FloatArray ?
-			std::any_cast<std::vector<float>>(value) : defaultValue;
+	auto array = std::get_if<std::pmr::vector<float>>(&value);
+	return array ? std::vector<float> { array->begin(), array->end() } : defaultValue;
 }
 
 std::vector<double> LogTable::LogValue::GetDoubleArray(
 		std::vector<double> defaultValue) const {
-	return type == LoggableType::DoubleArray ?
-			std::any_cast<std::vector<double>>(value) : defaultValue;
+	auto array = std::get_if<std::pmr::vector<double>>(&value);
+	return array ? std::vector<double> { array->begin(), array->end() } : defaultValue;
 }
 
 std::vector<std::string> LogTable::LogValue::GetStringArray(
 		std::vector<std::string> defaultValue) const {
-	return type == LoggableType::StringArray ?
-			std::any_cast < std::vector < std::string >> (value) : defaultValue;
+	auto array = std::get_if<std::pmr::vector<std::pmr::string>>(&value);
+	return array ?
+			std::vector<std::string> { array->begin(), array->end() } :
+			defaultValue;
+}
+
+const std::string& LogTable::LogValue::GetCustomTypeStr() const {
+	return StringRegistry::GetString(customType);
+}
+
+const std::string& LogTable::LogValue::GetUnitStr() const {
+	return StringRegistry::GetString(unit);
 }
 
 std::string LogTable::LogValue::GetWPILOGType() const {
-	if (customTypeStr.empty())
+	if (customType == StringRegistry::EMPTY)
 		return std::string { WPILOG_TYPES[static_cast<int>(type)] };
-	return customTypeStr;
+	return GetCustomTypeStr();
 }
 
 std::string LogTable::LogValue::GetNT4Type() const {
-	if (customTypeStr.empty())
+	if (customType == StringRegistry::EMPTY)
 		return std::string { NT4_TYPES[static_cast<int>(type)] };
-	return customTypeStr;
+	return GetCustomTypeStr();
 }
 
 bool LogTable::LogValue::operator==(const LogValue &other) const {
-	if (other.type == type && customTypeStr == other.customTypeStr
-			&& unitStr == other.unitStr
-			&& (customTypeStr.empty() || other.customTypeStr == customTypeStr)
-			&& (unitStr.empty() || other.unitStr == unitStr)) {
-		switch (type) {
-		case LoggableType::Raw:
-			return GetRaw() == other.GetRaw();
-		case LoggableType::Boolean:
-			return GetBoolean() == other.GetBoolean();
-		case LoggableType::Integer:
-			return GetInteger() == other.GetInteger();
-		case LoggableType::Float:
-			return GetFloat() == other.GetFloat();
-		case LoggableType::Double:
-			return GetDouble() == other.GetDouble();
-		case LoggableType::String:
-			return GetString() == other.GetString();
-		case LoggableType::BooleanArray:
-			return GetBooleanArray() == other.GetBooleanArray();
-		case LoggableType::IntegerArray:
-			return GetIntegerArray() == other.GetIntegerArray();
-		case LoggableType::FloatArray:
-			return GetFloatArray() == other.GetFloatArray();
-		case LoggableType::DoubleArray:
-			return GetDoubleArray() == other.GetDoubleArray();
-		case LoggableType::StringArray:
-			return GetStringArray() == other.GetStringArray();
+	return type == other.type && customType == other.customType
+			&& unit == other.unit && value == other.value;
+}
+
+LogTable LogTable::Snapshot(std::shared_ptr<CycleArena> arena) {
+	auto snapshot = std::make_shared < Storage > (GetTimestamp());
+	snapshot->revision = storage->revision;
+	auto &chunks = storage->chunks;
+	auto &snapshotChunks = storage->snapshotChunks;
+	snapshotChunks.resize(chunks.size());
+
+	snapshot->chunks.reserve(chunks.size());
+	for (size_t index = 0; index < chunks.size(); index++) {
+		const auto &source = chunks[index];
+		if (source
+				&& (source->revision == storage->revision
+						|| !snapshotChunks[index])) {
+			auto chunk = std::make_shared<Chunk>();
+			chunk->arena = arena;
+			for (size_t i = 0; i < CHUNK_SIZE; i++) {
+				if (const auto &value = source->values[i])
+					chunk->values[i].emplace(*value, arena.get());
+			}
+			chunk->revisions = source->revisions;
+			chunk->revision = source->revision;
+			snapshotChunks[index] = std::move(chunk);
+		} else if (source && snapshotChunks[index]->arena) {
+			// The first time a chunk is reused, it moves to the heap, so an
+			// arena is only held by the snapshot of the cycle that filled it
+			const Chunk &shared = *snapshotChunks[index];
+			auto chunk = std::make_shared<Chunk>();
+			for (size_t i = 0; i < CHUNK_SIZE; i++) {
+				if (const auto &value = shared.values[i])
+					chunk->values[i].emplace(*value,
+							std::pmr::get_default_resource());
+			}
+			chunk->revisions = shared.revisions;
+			chunk->revision = shared.revision;
+			snapshotChunks[index] = std::move(chunk);
 		}
+		snapshot->chunks.push_back(snapshotChunks[index]);
 	}
-	return false;
+	snapshot->samples = std::move(storage->samples);
+	storage->revision++;
+	return LogTable { "/", 0, std::move(snapshot) };
 }
 
 std::unordered_map<std::string, LogTable::LogValue> LogTable::GetAll(
 		bool subtableOnly) {
-	if (subtableOnly) {
-		std::unordered_map < std::string, LogValue > result;
-		for (const auto &field : data) {
-			if (field.first.starts_with(prefix))
-				result.emplace(field.first.substr(prefix.size()), field.second);
-		}
-		return result;
-	} else
-		return data;
+	std::unordered_map < std::string, LogValue > result;
+	ForEach(subtableOnly, [&](std::string_view key, const LogValue &value) {
+		result.emplace(key, value);
+	});
+	return result;
+}
+
+KeyRegistry::FieldId LogTable::GetFieldId(std::string_view key) const {
+	// Reused across calls so building the full path does not allocate
+	thread_local std::string path;
+	path.assign(prefix);
+	path.append(key);
+	return KeyRegistry::GetId(path);
+}
+
+std::optional<KeyRegistry::FieldId> LogTable::FindFieldId(
+		std::string_view key) const {
+	thread_local std::string path;
+	path.assign(prefix);
+	path.append(key);
+	return KeyRegistry::FindId(path);
+}
+
+const LogTable::NestedKeys& LogTable::GetNestedKeys(KeyRegistry::FieldId base,
+		size_t rowCount) {
+	thread_local std::unordered_map<KeyRegistry::FieldId, NestedKeys> cache;
+	auto [entry, inserted] = cache.try_emplace(base);
+	NestedKeys &keys = entry->second;
+	if (inserted)
+		keys.length = KeyRegistry::GetId(KeyRegistry::GetKey(base) + "/length");
+	while (keys.rows.size() < rowCount)
+		keys.rows.push_back(
+				KeyRegistry::GetId(
+						KeyRegistry::GetKey(base) + "/"
+								+ std::to_string(keys.rows.size())));
+	return keys;
+}
+
+const LogTable::LogValue* LogTable::Find(std::string_view key) const {
+	auto id = FindFieldId(key);
+	return id ? Find(*id) : nullptr;
+}
+
+void LogTable::Set(KeyRegistry::FieldId id, LogValue value) {
+	const LogValue *currentValue = Find(id);
+	if (currentValue && *currentValue == value)
+		return;
+
+	Chunk &chunk = GetWritableChunk(id / CHUNK_SIZE);
+	chunk.values[id % CHUNK_SIZE] = std::move(value);
+	chunk.revisions[id % CHUNK_SIZE] = chunk.revision = storage->revision;
+}
+
+void LogTable::Remove(KeyRegistry::FieldId id) {
+	if (!Find(id))
+		return;
+	Chunk &chunk = GetWritableChunk(id / CHUNK_SIZE);
+	chunk.values[id % CHUNK_SIZE].reset();
+	chunk.revisions[id % CHUNK_SIZE] = chunk.revision = storage->revision;
+}
+
+LogTable::Chunk& LogTable::GetWritableChunk(size_t index) {
+	auto &chunks = storage->chunks;
+	// Grown to the written chunk rather than the registry's size, so writes
+	// on other threads' staging tables never take the registry's lock
+	if (index >= chunks.size())
+		chunks.resize(index + 1);
+
+	auto &chunk = chunks[index];
+	if (!chunk) {
+		chunk = std::make_shared<Chunk>();
+	} else if (chunk.use_count() > 1 || chunk->arena) {
+		// Shared with a copy or snapshot, or backed by a cycle arena
+		auto copy = std::make_shared < Chunk > (*chunk);
+		copy->arena = nullptr;
+		chunk = std::move(copy);
+	}
+	return *chunk;
 }
 
-bool LogTable::WriteAllowed(std::string key, LoggableType type,
-		std::string customTypeStr) {
-	auto currentValue = data.find(prefix + key);
-	if (currentValue == data.end())
+bool LogTable::WriteAllowed(KeyRegistry::FieldId id, LoggableType type,
+		StringRegistry::StringId customType) {
+	const LogValue *currentValue = Find(id);
+	if (!currentValue)
 		return true;
-	if (currentValue->second.type != type) {
+	if (currentValue->type != type) {
 		FRC_ReportWarning(
-				"[AdvantageKit] Failed to write to field \"{}{}\" - attempted to write {} value but expected {}",
-				prefix, key, magic_enum::enum_name(type),
-				magic_enum::enum_name(currentValue->second.type));
+				"[AdvantageKit] Failed to write to field \"{}\" - attempted to write {} value but expected {}",
+				KeyRegistry::GetKey(id), magic_enum::enum_name(type),
+				magic_enum::enum_name(currentValue->type));
 		return false;
 	}
-	if (currentValue->second.customTypeStr != customTypeStr) {
+	if (currentValue->customType != customType) {
 		FRC_ReportWarning(
-				"[AdvantageKit] Failed to write to field \"{}{}\" - attempted to write {} value but expected {}",
-				prefix, key, customTypeStr, currentValue->second.customTypeStr);
+				"[AdvantageKit] Failed to write to field \"{}\" - attempted to write {} value but expected {}",
+				KeyRegistry::GetKey(id), StringRegistry::GetString(customType),
+				currentValue->GetCustomTypeStr());
 		return false;
 	}
 	return true;
 }
 
 void LogTable::Put(std::string key, LogTable::LogValue value) {
-	if (WriteAllowed(key, value.type, value.customTypeStr))
-		data.emplace(prefix + key, value);
+	Put(GetFieldId(key), std::move(value));
 }
 
-void LogTable::AddStructSchema(std::string typeString, std::string schema,
-		std::unordered_set<std::string> &seen) {
-	std::string key = "/.schema/" + typeString;
+void LogTable::Put(KeyRegistry::FieldId id, LogValue value) {
+	if (WriteAllowed(id, value.type, value.customType))
+		Set(id, std::move(value));
+}
+
+void LogTable::ApplyChanges(const LogTable &other, uint64_t sinceRevision) {
+	other.ForEachChange(sinceRevision,
+			[&](KeyRegistry::FieldId id, const LogValue &value) {
+				Put(id, value);
+			});
+}
 
-	if (data.contains(key))
+void LogTable::AddSample(Sample sample) {
+	const LogValue *currentValue = Find(sample.id);
+	if ((currentValue && *currentValue == sample.value)
+			|| !WriteAllowed(sample.id, sample.value.type,
+					sample.value.customType))
 		return;
-	seen.insert(typeString);
+	Set(sample.id, sample.value);
 
-	data.emplace(key,
-			LogValue {
-					std::vector<std::byte> {
-							reinterpret_cast<std::byte*>(schema.data()),
-							reinterpret_cast<std::byte*>(schema.data())
-									+ schema.size() }, "" });
+	auto &samples = storage->samples;
+	if (!samples)
+		samples = std::make_shared<std::vector<Sample>>();
+	else if (samples.use_count() > 1)
+		samples = std::make_shared < std::vector < Sample >> (*samples);
+	samples->push_back(std::move(sample));
+}
+
+void LogTable::AddStructSchema(std::string_view typeString,
+		std::string_view schema) {
+	thread_local std::string path;
+	path.assign("/.schema/");
+	path.append(typeString);
+	KeyRegistry::FieldId id = KeyRegistry::GetId(path);
+
+	if (Find(id))
+		return;
+	Set(id, LogValue { std::as_bytes(std::span { schema }), "structschema" });
 }
 
 std::vector<std::byte> LogTable::Get(std::string key,
 		std::vector<std::byte> defaultValue) {
-	if (data.contains(prefix + key))
-		return Get(key).GetRaw(defaultValue);
+	if (const LogValue *value = Find(key))
+		return value->GetRaw(defaultValue);
 	else
 		return defaultValue;
 }
 
 bool LogTable::Get(std::string key, bool defaultValue) {
-	if (data.contains(prefix + key))
-		return Get(key).GetBoolean(defaultValue);
+	if (const LogValue *value = Find(key))
+		return value->GetBoolean(defaultValue);
 	else
 		return defaultValue;
 }
 
 std::vector<bool> LogTable::Get(std::string key,
 		std::vector<bool> defaultValue) {
-	if (data.contains(prefix + key))
-		return Get(key).GetBooleanArray(defaultValue);
+	if (const LogValue *value = Find(key))
+		return value->GetBooleanArray(defaultValue);
 	else
 		return defaultValue;
 }
 
 float LogTable::Get(std::string key, float defaultValue) {
-	if (data.contains(prefix + key))
-		return Get(key).GetFloat(defaultValue);
+	if (const LogValue *value = Find(key))
+		return value->GetFloat(defaultValue);
 	else
 		return defaultValue;
 }
 
 std::vector<float> LogTable::Get(std::string key,
 		std::vector<float> defaultValue) {
-	if (data.contains(prefix + key))
-		return Get(key).GetFloatArray(defaultValue);
+	if (const LogValue *value = Find(key))
+		return value->GetFloatArray(defaultValue);
 	else
 		return defaultValue;
 }
 
 double LogTable::Get(std::string key, double defaultValue) {
-	if (data.contains(prefix + key))
-		return Get(key).GetInteger(defaultValue);
+	if (const LogValue *value = Find(key))
+		return value->GetDouble(defaultValue);
 	else
 		return defaultValue;
 }
 
 std::vector<double> LogTable::Get(std::string key,
 		std::vector<double> defaultValue) {
-	if (data.contains(prefix + key))
-		return Get(key).GetDoubleArray(defaultValue);
+	if (const LogValue *value = Find(key))
+		return value->GetDoubleArray(defaultValue);
 	else
 		return defaultValue;
 }
 
 std::string LogTable::Get(std::string key, std::string defaultValue) {
-	if (data.contains(prefix + key))
-		return Get(key).GetString(defaultValue);
+	if (const LogValue *value = Find(key))
+		return value->GetString(defaultValue);
 	else
 		return defaultValue;
 }
 
 std::vector<std::string> LogTable::Get(std::string key,
 		std::vector<std::string> defaultValue) {
-	if (data.contains(prefix + key))
-		return Get(key).GetStringArray(defaultValue);
+	if (const LogValue *value = Find(key))
+		return value->GetStringArray(defaultValue);
 	else
 		return defaultValue;
 }
 
 frc::Color LogTable::Get(std::string key, frc::Color defaultValue) {
-	if (data.contains(prefix + key))
-		return frc::Color { Get(key).GetString(defaultValue.HexString()) };
+	if (const LogValue *value = Find(key))
+		return frc::Color { value->GetString(defaultValue.HexString()) };
 	else
 		return defaultValue;
 }
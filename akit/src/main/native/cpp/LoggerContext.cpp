@@ -0,0 +1,379 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <frc/RobotBase.h>
+#include <frc/RobotController.h>
+#include <frc/Timer.h>
+#include "akit/LoggerContext.h"
+#include "akit/LoggedDriverStation.h"
+#include "akit/LoggedSystemStats.h"
+#include "akit/LoggedPowerDistribution.h"
+#include "akit/RadioLogger.h"
+#include "akit/conduit/ConduitApi.h"
+#include "akit/LoggedRobot.h"
+#include "akit/Profiler.h"
+
+using namespace akit;
+
+thread_local LoggerContext *LoggerContext::current = nullptr;
+std::atomic<int> LoggerContext::runningContexts = 0;
+
+LoggerContext::LoggerContext() = default;
+
+LoggerContext::~LoggerContext() {
+	End();
+}
+
+LoggerContext& LoggerContext::GetDefault() {
+	// Never destroyed, so the robot's session is not ended during static
+	// destruction at exit
+	static LoggerContext *context = new LoggerContext();
+	return *context;
+}
+
+void LoggerContext::SetReplaySource(std::unique_ptr<LogReplaySource> replaySource) {
+	if (!running) {
+		this->replaySource = std::move(replaySource);
+		replaying = static_cast<bool>(this->replaySource);
+	}
+}
+
+void LoggerContext::AddDataReceiver(std::unique_ptr<LogDataReceiver> dataReceiver) {
+	if (!running)
+		dataReceivers.push_back(std::move(dataReceiver));
+}
+
+void LoggerContext::RegisterDashboardInput(
+		akit::nt::LoggedNetworkInput &dashboardInput) {
+	dashboardInputs.push_back(&dashboardInput);
+}
+
+void LoggerContext::RecordMetadata(std::string key, std::string value) {
+	if (!running)
+		metadata.insert( { key, value });
+}
+
+void LoggerContext::SetReceiverQueuePolicy(ReceiverQueue::Policy policy,
+		units::millisecond_t deadline) {
+	if (!running) {
+		receiverPolicy = policy;
+		receiverDeadline = deadline;
+	}
+}
+
+void LoggerContext::SetLowPriorityPrefixes(std::vector<std::string> prefixes) {
+	if (!running)
+		lowPriorityPrefixes = std::move(prefixes);
+}
+
+void LoggerContext::Start() {
+	if (!running) {
+		loggingThread = std::this_thread::get_id();
+		running = true;
+
+		if (checkRobotBase && !LoggedRobot::isLoggedRobot) {
+			FRC_ReportError(frc::err::Error,
+					"The main robot class must inherit from LoggedRobot when using AdvantageKit. For more details, check the AdvantageKit installation documentation: https://docs.advantagekit.org/getting-started/installation\n\n*** EXITING DUE TO INVALID ADVANTAGEKIT INSTALLATION, SEE ABOVE. ***");
+			std::exit(1);
+		}
+
+		if (replaySource) {
+			const char *halSimEnv = std::getenv("HALSIM_EXTENSIONS");
+			if (halSimEnv != NULL && std::strlen(halSimEnv) > 0) {
+				FRC_ReportError(frc::err::IncompatibleMode,
+						"All HAL simulation extensions must be disabled when running AdvantageKit replay, including the simulation GUI and DriverStation connection. Check the configuration in \"build.gradle\" and ensure that all checkboxes are disabled in the VSCode simulation popup.\n\n*** EXITING DUE TO INVALID SIMULATION CONFIGURATION, SEE ABOVE. ***");
+				std::exit(1);
+			}
+		}
+
+		if (enableConsole && !console && IsDefault()) {
+			if (frc::RobotBase::IsReal())
+				console = std::make_unique<RoboRIOConsoleSource>();
+			else
+				console = std::make_unique<SimulatorConsoleSource>();
+		}
+
+		// A new thread each session, since End stops the last one
+		receiverThread = std::make_unique < ReceiverThread
+				> (RECEIVER_QUEUE_CAPACITY);
+		for (auto &dataReceiver : dataReceivers)
+			receiverThread->AddDataReceiver(dataReceiver);
+		if (replaySource) {
+			// Every replayed cycle must reach the receivers for the replay log
+			// to match, so they wait for space rather than dropping cycles
+			receiverThread->SetPolicy(ReceiverQueue::Policy::BLOCK);
+			replaySource->Start();
+		} else
+			receiverThread->SetPolicy(receiverPolicy, receiverDeadline);
+
+		if (!replaySource)
+			outputTable = entry.GetSubtable("RealOutputs");
+		else
+			outputTable = entry.GetSubtable("ReplayOutputs");
+
+		LogTable metadataTable = entry.GetSubtable(
+				replaySource ? "RealMetadata" : "ReplayMetadata");
+		for (auto &entry : metadata)
+			metadataTable.Put(entry.first, entry.second);
+
+		// Receivers on the worker threads see this context, like the robot
+		// code on this thread
+		receiverThread->Start([this] {
+			current = this;
+		});
+
+		// Reads the context of the calling thread, so each replay thread
+		// gets its own log time
+		if (runningContexts++ == 0)
+			frc::RobotController::SetTimeSource([] {
+				return units::microsecond_t { GetCurrent().GetTimestamp() }.value();
+			});
+
+		PeriodicBeforeUser();
+	}
+}
+
+ReceiverThread::DrainResult LoggerContext::End() {
+	ReceiverThread::DrainResult drain;
+	if (running) {
+		running = false;
+		console.reset();
+
+		// A replay log is only complete with every cycle, so it is drained
+		// without a deadline
+		drain = receiverThread->Stop(
+				replaySource ?
+						std::nullopt :
+						std::optional<units::millisecond_t> { shutdownDeadline });
+		receiverThread.reset();
+		if (drain.droppedCycles > 0)
+			FRC_ReportError(frc::err::Error,
+					"[AdvantageKit] Receivers did not finish before the shutdown deadline, {} queued cycles were NOT logged",
+					drain.droppedCycles);
+
+		replaySource.reset();
+		replaying = false;
+		if (--runningContexts == 0)
+			frc::RobotController::SetTimeSource(
+					frc::RobotController::GetFPGATime);
+	}
+	return drain;
+}
+
+void LoggerContext::PeriodicBeforeUser() {
+	cycleCount++;
+	if (running) {
+		AKIT_PROFILE_SPAN(entryUpdate, "Logger/EntryUpdate");
+		if (!replaySource) {
+			entry.SetTimestamp(frc::Timer::GetFPGATimestamp());
+		} else {
+			if (!replaySource->UpdateTable(entry)) {
+				End();
+				// Other contexts are replays run by a harness, which stops
+				// once IsRunning is false
+				if (IsDefault())
+					std::exit(1);
+				return;
+			}
+			// Published every cycle, so each thread replays the same cycles
+			// however early it first reads. Unchanged chunks are shared.
+			auto replayed = std::make_shared<LogTable>(
+					entry.Snapshot(CycleArena::Acquire()));
+			std::lock_guard lock { replayedTableMutex };
+			replayedTable = std::move(replayed);
+		}
+		units::millisecond_t entryUpdateLength = entryUpdate.End();
+
+		AKIT_PROFILE_SPAN(driverStation, "Logger/DriverStation");
+		if (HasReplaySource() && IsDefault())
+			LoggedDriverStation::ReplayFromLog(
+					entry.GetSubtable("DriverStation"));
+		units::millisecond_t driverStationLength = driverStation.End();
+
+		AKIT_PROFILE_SPAN(dashboardInputsSpan, "Logger/DashboardInputs");
+		for (auto &input : dashboardInputs)
+			input->Periodic();
+		units::millisecond_t dashboardInputsLength = dashboardInputsSpan.End();
+
+		RecordOutput("Logger/EntryUpdateMS", entryUpdateLength);
+		if (HasReplaySource())
+			RecordOutput("Logger/DriverStationMS", driverStationLength);
+		RecordOutput("Logger/DashboardInputsMS", dashboardInputsLength);
+	}
+}
+
+void LoggerContext::PeriodicAfterUser(units::millisecond_t userCodeLength,
+		units::millisecond_t periodicBeforeLength,
+		std::string extraConsoleData) {
+	if (running) {
+		AKIT_PROFILE_SPAN(periodicAfter, "Logger/PeriodicAfterUser");
+
+		AKIT_PROFILE_SPAN(mergeStaged, "Logger/MergeStaged");
+		size_t stagedSamples = stager.MergeInto(entry);
+		units::millisecond_t mergeStagedLength = mergeStaged.End();
+
+		AKIT_PROFILE_SPAN(scheduledTasks, "Logger/Scheduler");
+		scheduler.Run();
+		units::millisecond_t scheduledTasksLength = scheduledTasks.End();
+
+		AKIT_PROFILE_SPAN(conduitCapture, "Logger/ConduitCapture");
+		// Conduit data is only saved when not replaying
+		if (!HasReplaySource()) {
+			conduit::ConduitApi &inst = conduit::ConduitApi::getInstance();
+			inst.captureData();
+		}
+		units::millisecond_t conduitCaptureLength = conduitCapture.End();
+
+		AKIT_PROFILE_SPAN(driverStation, "Logger/DriverStation");
+		if (!HasReplaySource())
+			LoggedDriverStation::SaveToLog(entry.GetSubtable("DriverStation"));
+		units::millisecond_t driverStationLength = driverStation.End();
+
+		AKIT_PROFILE_SPAN(conduitSave, "Logger/ConduitSave");
+		if (!HasReplaySource()) {
+			LoggedSystemStats::SaveToLog(entry.GetSubtable("SystemStats"));
+			LoggedPowerDistribution &loggedPowerDistribution =
+					LoggedPowerDistribution::GetInstance();
+			loggedPowerDistribution.SaveToLog(
+					entry.GetSubtable("PowerDistribution"));
+		}
+		units::millisecond_t conduitSaveLength = conduitSave.End();
+
+		AKIT_PROFILE_SPAN(autoLog, "Logger/AutoLog");
+		GetAutoLogOutputs().Poll();
+		units::millisecond_t autoLogLength = autoLog.End();
+		AKIT_PROFILE_SPAN(alertLog, "Logger/AlertLog");
+		units::millisecond_t alertLogLength = alertLog.End();
+
+		AKIT_PROFILE_SPAN(radioLog, "Logger/RadioLog");
+		if (!HasReplaySource())
+			RadioLogger::Periodic(entry.GetSubtable("RadioStatus"));
+		units::millisecond_t radioLogLength = radioLog.End();
+
+		AKIT_PROFILE_SPAN(consoleCapture, "Logger/Console");
+		if (enableConsole && console) {
+			std::string consoleData = console->GetNewData();
+			consoleData += extraConsoleData;
+			if (!consoleData.empty())
+				RecordOutput("Console", consoleData);
+		}
+		units::millisecond_t consoleLength = consoleCapture.End();
+
+		RecordOutput("Logger/ConduitCaptureMS", conduitCaptureLength);
+		if (!HasReplaySource())
+			RecordOutput("Logger/DriverStationMS", driverStationLength);
+		RecordOutput("Logger/ConduitSaveMS", conduitSaveLength);
+		RecordOutput("Logger/AutoLogMS", autoLogLength);
+		RecordOutput("Logger/AlertLogMS", alertLogLength);
+		RecordOutput("Logger/RadioLogMS", radioLogLength);
+		RecordOutput("Logger/ConsoleMS", consoleLength);
+		RecordOutput("Logger/SchedulerMS", scheduledTasksLength);
+		RecordOutput("Logger/MergeStagedMS", mergeStagedLength);
+		RecordOutput("Logger/StagedSamples", stagedSamples);
+		RecordOutput("Logger/SchedulerPredictedPeakMS",
+				scheduler.GetPredictedPeak());
+		units::millisecond_t periodicAfterLength = periodicAfter.End();
+		RecordOutput("LoggedRobot/LogPeriodicMS",
+				periodicBeforeLength + periodicAfterLength);
+		RecordOutput("LoggedRobot/FullCycleMS",
+				periodicBeforeLength + userCodeLength + periodicAfterLength);
+		ReceiverQueue::Stats queueStats;
+		units::millisecond_t maxLag = 0_ms;
+		std::vector < ReceiverThread::ReceiverStats > receiverStats =
+				receiverThread->GetStats();
+		for (size_t i = 0; i < receiverStats.size(); i++) {
+			const auto &stats = receiverStats[i];
+			LogTable receiverTable = outputTable->GetSubtable(
+					"Logger/Receivers/" + std::to_string(i));
+			receiverTable.Put("QueuedCycles", stats.queue.size);
+			receiverTable.Put("QueueHighWater", stats.queue.highWater);
+			receiverTable.Put("DroppedCycles", stats.queue.droppedCycles);
+			receiverTable.Put("CoalescedCycles", stats.queue.coalescedCycles);
+			receiverTable.Put("LagMS", stats.lag);
+
+			queueStats.size = std::max(queueStats.size, stats.queue.size);
+			queueStats.highWater = std::max(queueStats.highWater,
+					stats.queue.highWater);
+			queueStats.droppedCycles += stats.queue.droppedCycles;
+			queueStats.coalescedCycles += stats.queue.coalescedCycles;
+			queueStats.lastBlockedTime += stats.queue.lastBlockedTime;
+			queueStats.degraded |= stats.queue.degraded;
+			maxLag = std::max(maxLag, stats.lag);
+		}
+		RecordOutput("Logger/QueuedCycles", queueStats.size);
+		RecordOutput("Logger/QueueHighWater", queueStats.highWater);
+		RecordOutput("Logger/DroppedCycles", queueStats.droppedCycles);
+		RecordOutput("Logger/CoalescedCycles", queueStats.coalescedCycles);
+		RecordOutput("Logger/QueueBlockedMS", queueStats.lastBlockedTime);
+		RecordOutput("Logger/QueueDegraded", queueStats.degraded);
+		RecordOutput("Logger/ReceiverLagMS", maxLag);
+		CycleArena::PoolStats arenaStats = CycleArena::GetPoolStats();
+		RecordOutput("Logger/ArenaBytes", arenaStats.lastCycleBytes);
+		RecordOutput("Logger/ArenaHighWaterBytes", arenaStats.highWaterBytes);
+		RecordOutput("Logger/ArenaCount", arenaStats.totalArenas);
+		RecordOutput("Logger/ArenaIdleCount", arenaStats.idleArenas);
+
+		if (IsDefault())
+			// Under the output table, so replay's timings never replace
+			// the logged ones
+			Profiler::Flush(outputTable->GetSubtable("Profiling"));
+
+		// Report once when cycles start being lost, not on every cycle
+		bool wasFaulted = receiverQueueFault;
+		receiverQueueFault = !receiverThread->PutTable(
+				entry.Snapshot(CycleArena::Acquire()));
+		if (receiverQueueFault && !wasFaulted)
+			FRC_ReportError(frc::err::Error,
+					"[AdvantageKit] Capacity of receiver queue exceeded, some cycles will NOT be logged");
+		receiverQueueDegraded = receiverThread->IsDegraded();
+	}
+}
+
+units::second_t LoggerContext::GetTimestamp() const {
+	if (!running)
+		return frc::Timer::GetFPGATimestamp();
+	return entry.GetTimestamp();
+}
+
+void LoggerContext::RunEveryN(size_t n, std::function<void()> function) {
+	if (cycleCount % n == 0)
+		function();
+}
+
+void LoggerContext::ProcessInputs(std::string key, inputs::LoggableInputs &inputs) {
+	if (running) {
+		if (replaySource) {
+			if (IsLoggingThread())
+				inputs.FromLog(entry.GetSubtable(key));
+			else
+				inputs.FromLog(GetReplayedTable().GetSubtable(key));
+		} else if (!IsShed(key)) {
+			if (IsLoggingThread())
+				inputs.ToLog(entry.GetSubtable(key));
+			else
+				Stage([&](LogTable &staging) {
+					inputs.ToLog(staging.GetSubtable(key));
+				});
+		}
+	}
+}
+
+units::second_t LoggerContext::GetSampleTimestamp() const {
+	if (replaying.load(std::memory_order_relaxed))
+		return entry.GetTimestamp();
+	return frc::Timer::GetFPGATimestamp();
+}
+
+LogTable LoggerContext::GetReplayedTable() {
+	std::shared_ptr<const LogTable> table;
+	{
+		std::lock_guard lock { replayedTableMutex };
+		table = replayedTable;
+	}
+	// Copies share the snapshot's chunks
+	return table ? *table : LogTable { entry.GetTimestamp() };
+}
@@ -0,0 +1,134 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include "akit/PeriodicScheduler.h"
+
+using namespace akit;
+
+PeriodicScheduler::TaskId PeriodicScheduler::Add(std::string name,
+		size_t period, std::function<void()> function) {
+	if (period == 0)
+		throw std::invalid_argument { "Task period must be at least one cycle" };
+
+	Task &task = tasks.emplace_back();
+	task.span = Profiler::RegisterSpan("Scheduler/" + name);
+	task.name = std::move(name);
+	task.period = period;
+	task.function = std::move(function);
+
+	// Place the new task around the existing ones without moving them
+	Load load = MakeLoad(GetHorizon());
+	AssignPhase(task, load);
+	UpdatePeak(load);
+	return tasks.size() - 1;
+}
+
+void PeriodicScheduler::Run() {
+	for (size_t i = 0; i < tasks.size(); i++) {
+		Task &task = tasks[i];
+		if (cycle % task.period != task.phase)
+			continue;
+
+		Profiler::Span span { task.span };
+		task.function();
+		double costMS = span.End().value();
+		task.costMS =
+				task.runs == 0 ?
+						costMS :
+						task.costMS + COST_SMOOTHING * (costMS - task.costMS);
+		task.maxCostMS = std::max(task.maxCostMS, costMS);
+		task.runs++;
+	}
+
+	cycle++;
+	if (cycle % REBALANCE_CYCLES == 0)
+		Rebalance();
+}
+
+void PeriodicScheduler::Rebalance() {
+	std::vector<Task*> order;
+	for (Task &task : tasks)
+		order.push_back(&task);
+	// Most expensive first, so cheap tasks fill the gaps between them
+	std::stable_sort(order.begin(), order.end(), [](Task *a, Task *b) {
+		return a->costMS > b->costMS
+				|| (a->costMS == b->costMS && a->period < b->period);
+	});
+
+	size_t horizon = GetHorizon();
+	Load load { std::vector<double>(horizon), std::vector<size_t>(horizon) };
+	for (Task *task : order)
+		AssignPhase(*task, load);
+	UpdatePeak(load);
+}
+
+void PeriodicScheduler::UpdatePeak(const Load &load) {
+	predictedPeak = units::millisecond_t { *std::max_element(
+			load.cost.begin(), load.cost.end()) };
+}
+
+std::vector<PeriodicScheduler::TaskStats> PeriodicScheduler::GetStats() const {
+	std::vector < TaskStats > stats;
+	for (const Task &task : tasks)
+		stats.push_back( { task.name, task.period, task.phase,
+				units::millisecond_t { task.costMS }, units::millisecond_t {
+						task.maxCostMS } });
+	return stats;
+}
+
+size_t PeriodicScheduler::GetHorizon() const {
+	// Past the cap, cycles beyond the horizon are assumed to repeat it
+	size_t horizon = 1;
+	for (const Task &task : tasks)
+		horizon = std::min(std::lcm(horizon, task.period), MAX_HORIZON);
+	return horizon;
+}
+
+PeriodicScheduler::Load PeriodicScheduler::MakeLoad(size_t horizon) const {
+	Load load { std::vector<double>(horizon), std::vector<size_t>(horizon) };
+	for (const Task &task : tasks) {
+		// Tasks still being added have no phase yet
+		if (task.phase >= task.period)
+			continue;
+		for (size_t c = task.phase; c < horizon; c += task.period) {
+			load.cost[c] += task.costMS;
+			load.count[c]++;
+		}
+	}
+	return load;
+}
+
+void PeriodicScheduler::AssignPhase(Task &task, Load &load) {
+	// Lowest peak cost, then fewest tasks sharing a cycle, then earliest
+	size_t horizon = load.cost.size();
+	size_t bestPhase = 0;
+	double bestCost = 0;
+	size_t bestCount = 0;
+	for (size_t phase = 0; phase < task.period; phase++) {
+		double peakCost = 0;
+		size_t peakCount = 0;
+		for (size_t c = phase; c < horizon; c += task.period) {
+			peakCost = std::max(peakCost, load.cost[c]);
+			peakCount = std::max(peakCount, load.count[c]);
+		}
+		if (phase == 0 || peakCost < bestCost
+				|| (peakCost == bestCost && peakCount < bestCount)) {
+			bestPhase = phase;
+			bestCost = peakCost;
+			bestCount = peakCount;
+		}
+	}
+
+	task.phase = bestPhase;
+	for (size_t c = bestPhase; c < horizon; c += task.period) {
+		load.cost[c] += task.costMS;
+		load.count[c]++;
+	}
+}
@@ -0,0 +1,94 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include "akit/PipelinedReplaySource.h"
+#include "akit/CycleArena.h"
+
+using namespace akit;
+
+PipelinedReplaySource::PipelinedReplaySource(
+		std::unique_ptr<LogReplaySource> source, size_t depth) : source {
+		std::move(source) }, queue { depth } {
+	queue.SetPolicy(ReceiverQueue::Policy::BLOCK);
+}
+
+PipelinedReplaySource::~PipelinedReplaySource() {
+	StopDecoding();
+}
+
+void PipelinedReplaySource::Start() {
+	source->Start();
+	StartDecoding();
+}
+
+bool PipelinedReplaySource::UpdateTable(LogTable &table) {
+	std::optional < LogTable > cycle = queue.Dequeue();
+	if (!cycle)
+		return false;
+	table.SetTimestamp(cycle->GetTimestamp());
+	if (replaceNext && applied) {
+		// Fields replayed before the seek that the new position lacks
+		applied->ForEach([&](KeyRegistry::FieldId id, const LogTable::LogValue&) {
+			if (!cycle->Find(id))
+				table.Remove(id);
+		});
+	}
+	table.ApplyChanges(*cycle,
+			applied && !replaceNext ? applied->GetRevision() : 0);
+	applied = std::move(cycle);
+	replaceNext = false;
+	return true;
+}
+
+bool PipelinedReplaySource::Seek(units::second_t timestamp) {
+	bool decoding = decodeThread.joinable();
+	// Cycles already queued are kept until the seek succeeds
+	StopDecoding();
+	bool seeked = source->Seek(timestamp);
+	if (seeked) {
+		queue.Discard();
+		// The seek writes the full state at the new cycle, so start from an
+		// empty table and apply all of it
+		decoded = LogTable { 0_s };
+		unqueued.reset();
+		replaceNext = true;
+	}
+	if (decoding) {
+		queue.Reopen();
+		StartDecoding();
+	}
+	return seeked;
+}
+
+void PipelinedReplaySource::StartDecoding() {
+	decodeThread = std::thread { [this] {
+		Decode();
+	} };
+}
+
+void PipelinedReplaySource::StopDecoding() {
+	queue.Close();
+	if (decodeThread.joinable())
+		decodeThread.join();
+}
+
+void PipelinedReplaySource::Decode() {
+	while (true) {
+		if (!unqueued) {
+			if (!source->UpdateTable(decoded)) {
+				queue.Close();
+				return;
+			}
+			unqueued = decoded.Snapshot(CycleArena::Acquire());
+		}
+		// Enqueue only fails once the queue is closed. The cycle is kept in
+		// case decoding restarts after a failed seek.
+		if (!queue.Enqueue(*unqueued))
+			return;
+		unqueued.reset();
+	}
+}
@@ -0,0 +1,94 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "akit/Profiler.h"
+
+using namespace akit;
+
+std::mutex Profiler::mutex;
+std::unordered_map<std::string, Profiler::SpanId> Profiler::ids;
+std::deque<Profiler::SpanInfo> Profiler::spans;
+uint64_t Profiler::droppedSpans = 0;
+
+Profiler::SpanId Profiler::RegisterSpan(std::string_view name) {
+	std::lock_guard lock { mutex };
+	auto existing = ids.find(std::string { name });
+	if (existing != ids.end())
+		return existing->second;
+	if (spans.size() > UINT16_MAX)
+		throw std::length_error { "Too many profiler spans" };
+
+	SpanId id = static_cast<SpanId>(spans.size());
+	std::string key { name };
+	SpanInfo &info = spans.emplace_back();
+	info.durationKey = key + "MS";
+	info.p50Key = key + "/P50MS";
+	info.p99Key = key + "/P99MS";
+	info.maxKey = key + "/MaxMS";
+	info.window.reserve(WINDOW_CYCLES);
+	info.sorted.reserve(WINDOW_CYCLES);
+	ids.emplace(std::move(key), id);
+	return id;
+}
+
+void Profiler::Flush(LogTable &&table) {
+	std::lock_guard lock { mutex };
+	Ring &buffer = ring;
+	if (buffer.next - buffer.flushed > RING_CAPACITY) {
+		droppedSpans += buffer.next - buffer.flushed - RING_CAPACITY;
+		buffer.flushed = buffer.next - RING_CAPACITY;
+	}
+
+	for (; buffer.flushed < buffer.next; buffer.flushed++) {
+		const Record &record = buffer.records[buffer.flushed % RING_CAPACITY];
+		SpanInfo &info = spans[record.id];
+		info.cycleTotal += std::chrono::duration<double, std::milli> {
+				record.duration }.count();
+		info.ranThisCycle = true;
+	}
+
+	for (SpanInfo &info : spans) {
+		if (!info.ranThisCycle)
+			continue;
+
+		// The window is kept sorted alongside the ring of recent durations,
+		// so each update is a binary search and a short move
+		if (info.window.size() < WINDOW_CYCLES) {
+			info.window.push_back(info.cycleTotal);
+		} else {
+			double &oldest = info.window[info.windowNext];
+			info.sorted.erase(
+					std::lower_bound(info.sorted.begin(), info.sorted.end(),
+							oldest));
+			oldest = info.cycleTotal;
+		}
+		info.windowNext = (info.windowNext + 1) % WINDOW_CYCLES;
+		info.sorted.insert(
+				std::upper_bound(info.sorted.begin(), info.sorted.end(),
+						info.cycleTotal), info.cycleTotal);
+
+		size_t count = info.sorted.size();
+		double p50Value = info.sorted[(count - 1) / 2];
+		double p99Value = info.sorted[static_cast<size_t>(std::ceil(
+				count * 0.99)) - 1];
+		double maxValue = info.sorted.back();
+
+		table.Put(info.durationKey, units::millisecond_t { info.cycleTotal });
+		table.Put(info.p50Key, units::millisecond_t { p50Value });
+		table.Put(info.p99Key, units::millisecond_t { p99Value });
+		table.Put(info.maxKey, units::millisecond_t { maxValue });
+
+		info.cycleTotal = 0;
+		info.ranThisCycle = false;
+	}
+
+	if (droppedSpans > 0)
+		table.Put("DroppedSpans", static_cast<int64_t>(droppedSpans));
+}
@@ -0,0 +1,129 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <algorithm>
+#include <chrono>
+#include "akit/ReceiverQueue.h"
+
+using namespace akit;
+
+void ReceiverQueue::SetPolicy(Policy policy, units::millisecond_t deadline) {
+	std::lock_guard lock { mutex };
+	this->policy = policy;
+	this->deadline = deadline;
+}
+
+bool ReceiverQueue::Enqueue(LogTable table) {
+	std::unique_lock lock { mutex };
+	stats.lastBlockedTime = 0_ms;
+	if (closed) {
+		stats.droppedCycles++;
+		return false;
+	}
+
+	bool discarded = false;
+	if (queue.size() >= capacity) {
+		switch (policy) {
+		case Policy::DROP_NEWEST:
+			stats.droppedCycles++;
+			return false;
+		case Policy::BLOCK_WITH_DEADLINE:
+		case Policy::BLOCK: {
+			auto start = std::chrono::steady_clock::now();
+			auto ready = [&] {
+				return queue.size() < capacity || closed;
+			};
+			bool hasSpace = true;
+			if (policy == Policy::BLOCK)
+				notFull.wait(lock, ready);
+			else
+				hasSpace = notFull.wait_for(lock,
+						std::chrono::duration<double, std::milli> {
+								deadline.value() }, ready);
+			stats.lastBlockedTime = units::millisecond_t {
+					std::chrono::duration<double, std::milli> {
+							std::chrono::steady_clock::now() - start }.count() };
+			if (!hasSpace || closed) {
+				stats.droppedCycles++;
+				return false;
+			}
+			break;
+		}
+		case Policy::DROP_OLDEST:
+			queue.pop_front();
+			stats.droppedCycles++;
+			discarded = true;
+			break;
+		case Policy::COALESCE:
+		case Policy::DEGRADE:
+			// The receiver is not using the newest queued cycle yet, so it can
+			// be replaced in place
+			queue.back() = std::move(table);
+			stats.coalescedCycles++;
+			if (policy == Policy::DEGRADE)
+				stats.degraded = true;
+			return false;
+		}
+	}
+
+	queue.push_back(std::move(table));
+	stats.highWater = std::max(stats.highWater, queue.size());
+	if (policy == Policy::DEGRADE && queue.size() >= capacity * 3 / 4)
+		stats.degraded = true;
+	lock.unlock();
+	notEmpty.notify_one();
+	return !discarded;
+}
+
+std::optional<LogTable> ReceiverQueue::Dequeue() {
+	std::unique_lock lock { mutex };
+	notEmpty.wait(lock, [&] {
+		return !queue.empty() || closed;
+	});
+	if (queue.empty())
+		return std::nullopt;
+	LogTable table = std::move(queue.front());
+	queue.pop_front();
+	if (queue.size() <= capacity / 4)
+		stats.degraded = false;
+	lock.unlock();
+	notFull.notify_one();
+	return table;
+}
+
+void ReceiverQueue::Close() {
+	{
+		std::lock_guard lock { mutex };
+		closed = true;
+	}
+	notEmpty.notify_all();
+	notFull.notify_all();
+}
+
+void ReceiverQueue::Reopen() {
+	std::lock_guard lock { mutex };
+	closed = false;
+}
+
+size_t ReceiverQueue::Discard() {
+	size_t discarded;
+	{
+		std::lock_guard lock { mutex };
+		discarded = queue.size();
+		queue.clear();
+		stats.droppedCycles += discarded;
+	}
+	notFull.notify_all();
+	return discarded;
+}
+
+ReceiverQueue::Stats ReceiverQueue::GetStats() const {
+	std::lock_guard lock { mutex };
+	Stats result = stats;
+	result.size = queue.size();
+	return result;
+}
@@ -5,29 +5,112 @@
 // license that can be found in the LICENSE file
 // at the root directory of this project.
 
+#include <chrono>
 #include "akit/ReceiverThread.h"
 
 using namespace akit;
 
-ReceiverThread::ReceiverThread(
-		moodycamel::BlockingConcurrentQueue<LogTable> &queue) : queue { queue } {
-	thread.detach();
+ReceiverThread::~ReceiverThread() {
+	Stop();
 }
 
 void ReceiverThread::AddDataReceiver(
-		std::unique_ptr<LogDataReceiver> receiver) {
-	dataReceivers.emplace_back(std::move(receiver));
+		std::shared_ptr<LogDataReceiver> receiver) {
+	auto &worker = workers.emplace_back(
+			std::make_shared < Worker > (std::move(receiver), queueCapacity));
+	worker->queue.SetPolicy(policy, deadline);
 }
 
-void ReceiverThread::Run() {
-	for (auto &receiver : dataReceivers)
-		receiver->Start();
+void ReceiverThread::SetPolicy(ReceiverQueue::Policy policy,
+		units::millisecond_t deadline) {
+	this->policy = policy;
+	this->deadline = deadline;
+	for (auto &worker : workers)
+		worker->queue.SetPolicy(policy, deadline);
+}
+
+void ReceiverThread::Start(std::function<void()> threadInit) {
+	for (auto &worker : workers)
+		worker->thread = std::thread { [worker, threadInit] {
+			if (threadInit)
+				threadInit();
+			worker->Run();
+			worker->finished.set_value();
+		} };
+}
+
+bool ReceiverThread::PutTable(const LogTable &table) {
+	latestTimestamp = table.GetTimestamp();
+	bool accepted = true;
+	for (auto &worker : workers)
+		accepted &= worker->queue.Enqueue(table);
+	return accepted;
+}
+
+std::vector<ReceiverThread::ReceiverStats> ReceiverThread::GetStats() const {
+	std::vector < ReceiverStats > result;
+	result.reserve(workers.size());
+	for (auto &worker : workers) {
+		ReceiverStats &stats = result.emplace_back();
+		stats.queue = worker->queue.GetStats();
+		if (stats.queue.size > 0)
+			stats.lag = latestTimestamp
+					- units::second_t { worker->finishedTimestamp.load() };
+	}
+	return result;
+}
 
-	while (true) {
-		std::optional < LogTable > entry;
-		queue.wait_dequeue(entry);
+bool ReceiverThread::IsDegraded() const {
+	for (auto &worker : workers) {
+		if (worker->queue.IsDegraded())
+			return true;
+	}
+	return false;
+}
+
+ReceiverThread::DrainResult ReceiverThread::Stop(
+		std::optional<units::millisecond_t> deadline) {
+	DrainResult result;
+	if (stopped)
+		return result;
+	stopped = true;
+
+	// Only the logging thread enqueues, so nothing is added between reading
+	// the size and closing
+	std::vector < size_t > queued;
+	for (auto &worker : workers) {
+		queued.push_back(worker->queue.GetStats().size);
+		worker->queue.Close();
+	}
+
+	auto end = std::chrono::steady_clock::now();
+	if (deadline)
+		end += std::chrono::duration_cast < std::chrono::steady_clock::duration
+				> (std::chrono::duration<double, std::milli> { deadline->value() });
+	for (size_t i = 0; i < workers.size(); i++) {
+		Worker &worker = *workers[i];
+		if (!worker.thread.joinable())
+			continue;
+		size_t dropped = 0;
+		if (deadline
+				&& worker.finished.get_future().wait_until(end)
+						== std::future_status::timeout) {
+			// Stuck in PutTable or End, which may never return
+			dropped = worker.queue.Discard();
+			worker.thread.detach();
+		} else
+			worker.thread.join();
+		result.flushedCycles += queued[i] - dropped;
+		result.droppedCycles += dropped;
+	}
+	return result;
+}
 
-		for (auto &receiver : dataReceivers)
-			receiver->PutTable(*entry);
+void ReceiverThread::Worker::Run() {
+	receiver->Start();
+	while (std::optional < LogTable > entry = queue.Dequeue()) {
+		receiver->PutTable(*entry);
+		finishedTimestamp = entry->GetTimestamp().value();
 	}
+	receiver->End();
 }
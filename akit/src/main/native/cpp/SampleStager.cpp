@@ -0,0 +1,34 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include "akit/SampleStager.h"
+
+using namespace akit;
+
+void SampleStager::Stage(const LogTable &table) {
+	units::second_t timestamp = table.GetTimestamp();
+	table.ForEach([&](KeyRegistry::FieldId id, const LogTable::LogValue &value) {
+		queue.enqueue(Write { LogTable::Sample { timestamp, id, value } });
+	});
+}
+
+size_t SampleStager::MergeInto(LogTable &table) {
+	size_t merged = 0;
+	while (size_t count = queue.try_dequeue_bulk(batch.begin(), batch.size())) {
+		for (size_t i = 0; i < count; i++) {
+			Write &write = *batch[i];
+			if (!write.key.empty())
+				write.sample.id = table.GetFieldId(write.key);
+			if (write.addSchema)
+				write.addSchema(table);
+			table.AddSample(std::move(write.sample));
+			batch[i].reset();
+		}
+		merged += count;
+	}
+	return merged;
+}
@@ -0,0 +1,46 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <mutex>
+#include <stdexcept>
+#include "akit/StringRegistry.h"
+
+using namespace akit;
+
+std::shared_mutex StringRegistry::mutex;
+std::unordered_map<std::string, StringRegistry::StringId,
+		StringRegistry::StringHash, std::equal_to<>> StringRegistry::ids {
+		{ "", EMPTY } };
+std::deque<std::string> StringRegistry::strings { "" };
+
+StringRegistry::StringId StringRegistry::GetId(std::string_view string) {
+	if (string.empty())
+		return EMPTY;
+
+	{
+		std::shared_lock lock { mutex };
+		auto existing = ids.find(string);
+		if (existing != ids.end())
+			return existing->second;
+	}
+
+	std::unique_lock lock { mutex };
+	auto existing = ids.find(string);
+	if (existing != ids.end())
+		return existing->second;
+	if (strings.size() > UINT16_MAX)
+		throw std::length_error { "Too many distinct type and unit strings" };
+	StringId id = static_cast<StringId>(strings.size());
+	strings.emplace_back(string);
+	ids.emplace(strings.back(), id);
+	return id;
+}
+
+const std::string& StringRegistry::GetString(StringId id) {
+	std::shared_lock lock { mutex };
+	return strings.at(id);
+}
@@ -0,0 +1,40 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <cctype>
+#include "akit/inputs/AutoLogInputs.h"
+
+using namespace akit::inputs;
+
+std::string AutoLogFields::GetKey(std::string_view field) {
+	if (field.starts_with("m_"))
+		field.remove_prefix(2);
+	std::string key { field };
+	if (!key.empty())
+		key[0] = std::toupper(static_cast<unsigned char>(key[0]));
+	return key;
+}
+
+void AutoLogFields::ResolveIds(const LogTable &table,
+		std::string_view fieldList) {
+	ids.clear();
+	while (!fieldList.empty()) {
+		size_t end = fieldList.find(',');
+		std::string_view field = fieldList.substr(0, end);
+		size_t first = field.find_first_not_of(" \t\n");
+		size_t last = field.find_last_not_of(" \t\n");
+		if (first != std::string_view::npos)
+			ids.push_back(
+					table.GetFieldId(
+							GetKey(field.substr(first, last - first + 1))));
+		if (end == std::string_view::npos)
+			break;
+		fieldList.remove_prefix(end + 1);
+	}
+	prefix = table.GetPrefix();
+	resolved = true;
+}
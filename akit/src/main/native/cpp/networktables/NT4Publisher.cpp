@@ -22,92 +22,82 @@ void NT4Publisher::PutTable(LogTable &table) {
 			units::microsecond_t { table.GetTimestamp() }.value(),
 			units::microsecond_t { table.GetTimestamp() }.value());
 
-	std::unordered_map < std::string, LogTable::LogValue > newMap =
-			table.GetAll(false);
-	std::unordered_map < std::string, LogTable::LogValue > oldMap =
-			lastTable.GetAll(false);
-
-	for (const auto &field : newMap) {
-		if (field.second == oldMap.at(field.first))
-			continue;
+	table.ForEachChange(lastRevision,
+			[&](KeyRegistry::FieldId id, const LogTable::LogValue &value) {
+		if (id >= publishers.size()) {
+			publishers.resize(KeyRegistry::Size());
+			units.resize(KeyRegistry::Size());
+		}
 
-		std::string key = field.first.substr(1);
-		std::string unit = field.second.unitStr;
-		auto publisher = publishers.find(key);
-		if (publisher == publishers.end()) {
-			publisher =
-					publishers.emplace(key,
-							akitTable->GetTopic(key).GenericPublish(
-									field.second.GetNT4Type(),
-									{ .sendAll = true })).first;
-			if (!unit.empty()) {
-				akitTable->GetTopic(key).SetProperty("unit",
-						"\"" + unit + "\"");
-				units[key] = unit;
-			}
+		auto &publisher = publishers[id];
+		if (!publisher) {
+			std::string key = KeyRegistry::GetKey(id).substr(1);
+			publisher = akitTable->GetTopic(key).GenericPublish(
+					value.GetNT4Type(), { .sendAll = true });
 		}
 
-		if (!unit.empty() && unit != units.at(key)) {
-			akitTable->GetTopic(key).SetProperty("unit", "\"" + unit + "\"");
-			units[key] = unit;
+		if (value.unit != StringRegistry::EMPTY && value.unit != units[id]) {
+			publisher->GetTopic().SetProperty("unit",
+					"\"" + value.GetUnitStr() + "\"");
+			units[id] = value.unit;
 		}
 
-		switch (field.second.type) {
+		switch (value.type) {
 		case LogTable::LoggableType::Raw: {
-			auto value = field.second.GetRaw();
-			publisher->second.SetRaw(std::span {
-					reinterpret_cast<uint8_t*>(value.data()), value.size() },
+			auto raw = value.GetRaw();
+			publisher->SetRaw(std::span {
+					reinterpret_cast<uint8_t*>(raw.data()), raw.size() },
 					units::microsecond_t { table.GetTimestamp() }.value());
 			break;
 		}
 		case LogTable::LoggableType::Boolean:
-			publisher->second.SetBoolean(field.second.GetBoolean(),
+			publisher->SetBoolean(value.GetBoolean(),
 					units::microsecond_t { table.GetTimestamp() }.value());
 			break;
 		case LogTable::LoggableType::BooleanArray: {
-			auto value = field.second.GetBooleanArray();
-			publisher->second.SetBooleanArray(std::vector<int> { value.begin(),
-					value.end() },
+			auto booleans = value.GetBooleanArray();
+			publisher->SetBooleanArray(std::vector<int> { booleans.begin(),
+					booleans.end() },
 					units::microsecond_t { table.GetTimestamp() }.value());
 			break;
 		}
 		case LogTable::LoggableType::Integer:
-			publisher->second.SetInteger(field.second.GetInteger(),
+			publisher->SetInteger(value.GetInteger(),
 					units::microsecond_t { table.GetTimestamp() }.value());
 			break;
 		case LogTable::LoggableType::IntegerArray: {
-			auto value = field.second.GetIntegerArray();
-			publisher->second.SetIntegerArray(std::vector<int64_t> {
-					value.begin(), value.end() },
+			auto integers = value.GetIntegerArray();
+			publisher->SetIntegerArray(std::vector<int64_t> {
+					integers.begin(), integers.end() },
 					units::microsecond_t { table.GetTimestamp() }.value());
 			break;
 		}
 		case LogTable::LoggableType::Float:
-			publisher->second.SetFloat(field.second.GetFloat(),
+			publisher->SetFloat(value.GetFloat(),
 					units::microsecond_t { table.GetTimestamp() }.value());
 			break;
 		case LogTable::LoggableType::FloatArray:
-			publisher->second.SetFloatArray(field.second.GetFloatArray(),
+			publisher->SetFloatArray(value.GetFloatArray(),
 					units::microsecond_t { table.GetTimestamp() }.value());
 			break;
 		case LogTable::LoggableType::Double:
-			publisher->second.SetDouble(field.second.GetDouble(),
+			publisher->SetDouble(value.GetDouble(),
 					units::microsecond_t { table.GetTimestamp() }.value());
 			break;
 		case LogTable::LoggableType::DoubleArray:
-			publisher->second.SetDoubleArray(field.second.GetDoubleArray(),
+			publisher->SetDoubleArray(value.GetDoubleArray(),
 					units::microsecond_t { table.GetTimestamp() }.value());
 			break;
 		case LogTable::LoggableType::String:
-			publisher->second.SetString(field.second.GetString(),
+			publisher->SetString(value.GetString(),
 					units::microsecond_t { table.GetTimestamp() }.value());
 			break;
 		case LogTable::LoggableType::StringArray:
-			publisher->second.SetStringArray(field.second.GetStringArray(),
+			publisher->SetStringArray(value.GetStringArray(),
 					units::microsecond_t { table.GetTimestamp() }.value());
 			break;
 		}
-	}
+	});
 
-	lastTable = table;
+	lastRevision = table.GetRevision();
 }
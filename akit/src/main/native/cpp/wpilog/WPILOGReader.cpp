@@ -5,12 +5,102 @@
 // license that can be found in the LICENSE file
 // at the root directory of this project.
 
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include "akit/wpilog/WPILOGReader.h"
 #include "akit/wpilog/WPILOGConstants.h"
 #include "akit/LogDataReceiver.h"
 
 using namespace akit::wpilog;
 
+namespace {
+
+constexpr std::string_view INDEX_MAGIC = "AKITIDX2";
+// Bytes hashed at each end of the log, which hold the header and the first
+// and last records
+constexpr size_t FINGERPRINT_BYTES = 4096;
+
+// Identifies the log an index was built from, so an index is not used with
+// a log that was rewritten or replaced since
+struct Fingerprint {
+	uint64_t size = 0;
+	int64_t modified = 0;
+	uint64_t hash = 0;
+
+	bool operator==(const Fingerprint&) const = default;
+};
+
+template<typename T>
+void Write(std::ostream &stream, T value) {
+	stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void WriteString(std::ostream &stream, std::string_view value) {
+	Write<uint32_t>(stream, value.size());
+	stream.write(value.data(), value.size());
+}
+
+template<typename T>
+T Read(std::istream &stream) {
+	T value { };
+	stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+	return value;
+}
+
+std::string ReadString(std::istream &stream) {
+	std::string value(Read<uint32_t>(stream), '\0');
+	stream.read(value.data(), value.size());
+	return value;
+}
+
+Fingerprint GetFingerprint(const std::string &filename) {
+	Fingerprint fingerprint;
+	std::error_code error;
+	fingerprint.size = std::filesystem::file_size(filename, error);
+	if (error)
+		return { };
+	fingerprint.modified =
+			std::filesystem::last_write_time(filename, error).time_since_epoch().count();
+
+	// FNV-1a over the first and last bytes
+	std::ifstream stream { filename, std::ios::binary };
+	std::vector<char> bytes(
+			std::min<uint64_t>(fingerprint.size, FINGERPRINT_BYTES));
+	uint64_t hash = 14695981039346656037ull;
+	for (uint64_t offset : { uint64_t { 0 }, fingerprint.size - bytes.size() }) {
+		stream.seekg(offset);
+		stream.read(bytes.data(), bytes.size());
+		for (char byte : bytes) {
+			hash ^= static_cast<uint8_t>(byte);
+			hash *= 1099511628211ull;
+		}
+	}
+	fingerprint.hash = stream ? hash : 0;
+	return fingerprint;
+}
+
+void WriteFingerprint(std::ostream &stream, const Fingerprint &fingerprint) {
+	Write<uint64_t>(stream, fingerprint.size);
+	Write<int64_t>(stream, fingerprint.modified);
+	Write<uint64_t>(stream, fingerprint.hash);
+}
+
+Fingerprint ReadFingerprint(std::istream &stream) {
+	Fingerprint fingerprint;
+	fingerprint.size = Read<uint64_t>(stream);
+	fingerprint.modified = Read<int64_t>(stream);
+	fingerprint.hash = Read<uint64_t>(stream);
+	return fingerprint;
+}
+
+int64_t ToMicroseconds(units::second_t time) {
+	return static_cast<int64_t>(units::microsecond_t { time }.value());
+}
+
+}
+
 void WPILOGReader::Start() {
 	reader = wpi::log::DataLogReader {
 			wpi::MemoryBuffer::GetFile(filename).value() };
@@ -18,7 +108,7 @@ void WPILOGReader::Start() {
 		FRC_ReportError(frc::err::Error,
 				"[AdvantageKit] The replay log is not a valid WPILOG file.");
 		isValid = false;
-	} else if (reader->GetExtraHeader() == WPILOGConstants::EXTRA_HEADER) {
+	} else if (reader->GetExtraHeader() != WPILOGConstants::EXTRA_HEADER) {
 		FRC_ReportError(frc::err::Error,
 				"[AdvantageKit] The replay log was not produced by AdvantageKit.");
 		isValid = false;
@@ -26,141 +116,386 @@ void WPILOGReader::Start() {
 		isValid = true;
 
 	iterator = reader->begin();
+
+	if (const char *window = std::getenv(WINDOW_ENV))
+		ApplyWindow(window);
 }
 
 bool WPILOGReader::UpdateTable(LogTable &table) {
 	if (!isValid)
 		return false;
+	if (endTimestamp && timestamp
+			&& *timestamp > ToMicroseconds(*endTimestamp))
+		return false;
+
+	if (pending) {
+		table.ApplyChanges(*pending, 0);
+		pending.reset();
+	}
+	return ReadCycle(table);
+}
+
+bool WPILOGReader::Seek(units::second_t target) {
+	if (!EnsureIndex())
+		return false;
+
+	auto next = std::upper_bound(cycles.begin(), cycles.end(),
+			ToMicroseconds(target), [](int64_t time, const Cycle &cycle) {
+				return time < cycle.timestamp;
+			});
+	size_t cycle = next == cycles.begin() ? 0 : next - cycles.begin() - 1;
+	// The first keyframe is at cycle 0, so there is always one at or before
+	auto keyframe = std::upper_bound(keyframes.begin(), keyframes.end(),
+			cycle, [](size_t cycle, const Keyframe &keyframe) {
+				return cycle < keyframe.cycle;
+			}) - 1;
+
+	LogTable state { 0_s };
+	for (size_t offset : keyframe->records) {
+		wpi::log::DataLogIterator recordIterator { &*reader, offset };
+		const auto &record = *recordIterator;
+		auto entry = entries.find(record.GetEntry());
+		if (entry != entries.end())
+			ReadValue(record, entry->second, state);
+	}
+
+	iterator = wpi::log::DataLogIterator { &*reader,
+			cycles[keyframe->cycle].offset };
+	timestamp = cycles[keyframe->cycle].timestamp;
+	for (size_t i = keyframe->cycle; i < cycle; i++)
+		ReadCycle(state);
+	pending = std::move(state);
+	return true;
+}
+
+void WPILOGReader::ReadStart(const wpi::log::DataLogRecord &record) {
+	wpi::log::StartRecordData startRecord;
+	record.GetStartData(&startRecord);
+
+	Entry entry;
+	entry.key = std::string { startRecord.name.substr(1) };
+	auto type = std::ranges::find(LogTable::WPILOG_TYPES, startRecord.type);
+	if (type != LogTable::WPILOG_TYPES.end())
+		entry.type = static_cast<LogTable::LoggableType>(std::distance(
+				LogTable::WPILOG_TYPES.begin(), type));
+	else if (startRecord.type == "json")
+		entry.type = LogTable::LoggableType::String;
+	else
+		entry.type = LogTable::LoggableType::Raw;
+	if ((entry.type == LogTable::LoggableType::Raw
+			&& startRecord.type != "raw") || startRecord.type == "json")
+		entry.customType = startRecord.type;
+	entry.isTimestamp = startRecord.name == LogDataReceiver::TIMESTAMP_KEY;
+	entry.isReplayOutput = entry.key.starts_with("ReplayOutputs");
+	entries[startRecord.entry] = std::move(entry);
+}
 
+bool WPILOGReader::ReadCycle(LogTable &table) {
 	if (timestamp)
-		table.SetTimestamp(*timestamp);
+		table.SetTimestamp(units::microsecond_t {
+				static_cast<double>(*timestamp) });
 
-	bool readError = false;
-	for (; *iterator < reader->end(); (*iterator)++) {
-		auto &record = **iterator;
+	for (; *iterator < reader->end(); ++*iterator) {
+		const auto &record = **iterator;
 		if (record.IsControl()) {
-			if (record.IsStart()) {
-				wpi::log::StartRecordData startRecord;
-				record.GetStartData(&startRecord);
-				entryIDs[startRecord.entry] = startRecord.name;
-				LogTable::LoggableType loggableType {
-						static_cast<int>(std::distance(
-								LogTable::WPILOG_TYPES.begin(),
-								std::ranges::find(LogTable::WPILOG_TYPES,
-										startRecord.type))) };
-				entryTypes[startRecord.entry] = loggableType;
-				if ((loggableType == LogTable::LoggableType::Raw
-						&& startRecord.type != "raw")
-						|| startRecord.type == "json")
-					entryCustomTypes[startRecord.entry] = startRecord.type;
+			if (record.IsStart())
+				ReadStart(record);
+			continue;
+		}
+
+		auto entry = entries.find(record.GetEntry());
+		if (entry == entries.end())
+			continue;
+		if (entry->second.isTimestamp) {
+			bool firstTimestamp = !timestamp;
+			int64_t time;
+			record.GetInteger(&time);
+			timestamp = time;
+			if (firstTimestamp) {
+				table.SetTimestamp(units::microsecond_t {
+						static_cast<double>(time) });
+			} else {
+				++*iterator;
+				break;
 			}
-		} else {
-			auto entry = entryIDs.find(record.GetEntry());
-			if (entry != entryIDs.end()) {
-				if (entry->second == LogDataReceiver::TIMESTAMP_KEY) {
-					bool firstTimestamp = timestamp.has_value();
-					int64_t time;
-					record.GetInteger(&time);
-					timestamp =
-							units::microsecond_t { static_cast<double>(time) };
-					if (firstTimestamp)
-						table.SetTimestamp(*timestamp);
-					else
-						break;
-				} else if (timestamp
-						&& units::microsecond_t {
-								static_cast<double>(record.GetTimestamp()) }
-								== timestamp) {
-					entry->second = entry->second.substr(1);
-					if (entry->second.starts_with("ReplayOutputs"))
-						continue;
-					std::string customType = entryCustomTypes[record.GetEntry()];
-					switch (entryTypes[record.GetEntry()]) {
-					case LogTable::LoggableType::Raw: {
-						auto value = record.GetRaw();
-						auto bytes = std::as_bytes(value);
-						table.Put(entry->second,
-								LogTable::LogValue { std::vector<std::byte> {
-										bytes.begin(), bytes.end() }, customType });
-						break;
-					}
-					case LogTable::LoggableType::Boolean: {
-						bool value;
-						record.GetBoolean(&value);
-						table.Put(entry->second, LogTable::LogValue { value,
-								customType });
-						break;
-					}
-					case LogTable::LoggableType::Integer: {
-						int64_t value;
-						record.GetInteger(&value);
-						table.Put(entry->second, LogTable::LogValue {
-								static_cast<long>(value), customType });
-						break;
-					}
-					case LogTable::LoggableType::Float: {
-						float value;
-						record.GetFloat(&value);
-						table.Put(entry->second, LogTable::LogValue { value,
-								customType });
-						break;
-					}
-					case LogTable::LoggableType::Double: {
-						double value;
-						record.GetDouble(&value);
-						table.Put(entry->second, LogTable::LogValue { value,
-								customType });
-						break;
-					}
-					case LogTable::LoggableType::String: {
-						std::string_view value;
-						record.GetString(&value);
-						table.Put(entry->second, LogTable::LogValue {
-								std::string { value }, customType });
-						break;
-					}
-					case LogTable::LoggableType::BooleanArray: {
-						std::vector<int> value;
-						record.GetBooleanArray(&value);
-						table.Put(entry->second,
-								LogTable::LogValue { std::vector<bool> {
-										value.begin(), value.end() }, customType });
-						break;
-					}
-					case LogTable::LoggableType::IntegerArray: {
-						std::vector < int64_t > value;
-						record.GetIntegerArray(&value);
-						table.Put(entry->second,
-								LogTable::LogValue { std::vector<long> {
-										value.begin(), value.end() }, customType });
-						break;
-					}
-					case LogTable::LoggableType::FloatArray: {
-						std::vector<float> value;
-						record.GetFloatArray(&value);
-						table.Put(entry->second, LogTable::LogValue { value,
-								customType });
-						break;
-					}
-					case LogTable::LoggableType::DoubleArray: {
-						std::vector<double> value;
-						record.GetDoubleArray(&value);
-						table.Put(entry->second, LogTable::LogValue { value,
-								customType });
-						break;
-					}
-					case LogTable::LoggableType::StringArray: {
-						std::vector < std::string_view > value;
-						record.GetStringArray(&value);
-						table.Put(entry->second,
-								LogTable::LogValue { std::vector<std::string> {
-										value.begin(), value.end() }, customType });
-						break;
-					}
-					}
-				}
+		} else if (timestamp && !entry->second.isReplayOutput)
+			// Fields are written at the cycle timestamp and samples at their
+			// own, which are all before the next cycle. Reading in file order
+			// leaves the latest sample, as in the table that was logged.
+			ReadValue(record, entry->second, table);
+	}
+	return *iterator < reader->end();
+}
+
+void WPILOGReader::ReadValue(const wpi::log::DataLogRecord &record,
+		const Entry &entry, LogTable &table) {
+	const std::string &key = entry.key;
+	const std::string &customType = entry.customType;
+	switch (entry.type) {
+	case LogTable::LoggableType::Raw: {
+		auto value = record.GetRaw();
+		auto bytes = std::as_bytes(value);
+		table.Put(key, LogTable::LogValue { std::vector<std::byte> {
+				bytes.begin(), bytes.end() }, customType });
+		break;
+	}
+	case LogTable::LoggableType::Boolean: {
+		bool value;
+		record.GetBoolean(&value);
+		table.Put(key, LogTable::LogValue { value, customType });
+		break;
+	}
+	case LogTable::LoggableType::Integer: {
+		int64_t value;
+		record.GetInteger(&value);
+		table.Put(key,
+				LogTable::LogValue { static_cast<long>(value), customType });
+		break;
+	}
+	case LogTable::LoggableType::Float: {
+		float value;
+		record.GetFloat(&value);
+		table.Put(key, LogTable::LogValue { value, customType });
+		break;
+	}
+	case LogTable::LoggableType::Double: {
+		double value;
+		record.GetDouble(&value);
+		table.Put(key, LogTable::LogValue { value, customType });
+		break;
+	}
+	case LogTable::LoggableType::String: {
+		std::string_view value;
+		record.GetString(&value);
+		table.Put(key, LogTable::LogValue { std::string { value }, customType });
+		break;
+	}
+	case LogTable::LoggableType::BooleanArray: {
+		std::vector<int> value;
+		record.GetBooleanArray(&value);
+		table.Put(key, LogTable::LogValue { std::vector<bool> { value.begin(),
+				value.end() }, customType });
+		break;
+	}
+	case LogTable::LoggableType::IntegerArray: {
+		std::vector < int64_t > value;
+		record.GetIntegerArray(&value);
+		table.Put(key, LogTable::LogValue { std::vector<long> { value.begin(),
+				value.end() }, customType });
+		break;
+	}
+	case LogTable::LoggableType::FloatArray: {
+		std::vector<float> value;
+		record.GetFloatArray(&value);
+		table.Put(key, LogTable::LogValue { value, customType });
+		break;
+	}
+	case LogTable::LoggableType::DoubleArray: {
+		std::vector<double> value;
+		record.GetDoubleArray(&value);
+		table.Put(key, LogTable::LogValue { value, customType });
+		break;
+	}
+	case LogTable::LoggableType::StringArray: {
+		std::vector < std::string_view > value;
+		record.GetStringArray(&value);
+		table.Put(key, LogTable::LogValue { std::vector<std::string> {
+				value.begin(), value.end() }, customType });
+		break;
+	}
+	}
+}
+
+void WPILOGReader::ApplyWindow(std::string_view window) {
+	size_t separator = window.find(':');
+	std::string start { window.substr(0, separator) };
+	std::string end {
+			separator == std::string_view::npos ?
+					"" : window.substr(separator + 1) };
+
+	bool valid = true;
+	auto parse = [&](const std::string &text) -> std::optional<units::second_t> {
+		if (text.empty())
+			return std::nullopt;
+		char *parsedEnd;
+		units::second_t time { std::strtod(text.c_str(), &parsedEnd) };
+		if (parsedEnd == text.c_str() || *parsedEnd != '\0') {
+			valid = false;
+			return std::nullopt;
+		}
+		if (time < 0_s) {
+			// Relative to the last cycle, which needs the index
+			if (!EnsureIndex())
+				return std::nullopt;
+			time += units::microsecond_t {
+					static_cast<double>(cycles.back().timestamp) };
+		}
+		return time;
+	};
+
+	std::optional<units::second_t> endTime = parse(end);
+	std::optional<units::second_t> startTime = parse(start);
+	if (!valid) {
+		FRC_ReportError(frc::err::Error,
+				"[AdvantageKit] Ignoring the replay window \"{}\" from {}, expected \"start:end\" in seconds.",
+				window, WINDOW_ENV);
+		return;
+	}
+	if (endTime)
+		SetEndTimestamp(*endTime);
+	if (startTime)
+		Seek(*startTime);
+}
+
+size_t WPILOGReader::OffsetAfter(const wpi::log::DataLogRecord &record) const {
+	// Records are contiguous, so the next one starts where this payload ends
+	const uint8_t *start =
+			reinterpret_cast<const uint8_t*>(reader->GetExtraHeader().data())
+					- HEADER_SIZE;
+	return record.GetRaw().data() + record.GetSize() - start;
+}
+
+bool WPILOGReader::EnsureIndex() {
+	if (!isValid)
+		return false;
+	if (!indexed) {
+		if (!persistIndex || !LoadIndex()) {
+			BuildIndex();
+			if (persistIndex)
+				SaveIndex();
+		}
+		indexed = true;
+	}
+	return !cycles.empty();
+}
+
+void WPILOGReader::BuildIndex() {
+	cycles.clear();
+	keyframes.clear();
+	// Offset of the latest record of each entry
+	std::unordered_map<int, size_t> latest;
+	bool inCycle = false;
+	size_t position = HEADER_SIZE + reader->GetExtraHeader().size();
+
+	for (const auto &record : *reader) {
+		size_t start = position;
+		position = OffsetAfter(record);
+		if (record.IsControl()) {
+			if (record.IsStart())
+				ReadStart(record);
+			continue;
+		}
+
+		auto entry = entries.find(record.GetEntry());
+		if (entry == entries.end())
+			continue;
+		if (entry->second.isTimestamp) {
+			if (cycles.size() % KEYFRAME_INTERVAL == 0) {
+				Keyframe &keyframe = keyframes.emplace_back();
+				keyframe.cycle = cycles.size();
+				for (const auto &[id, offset] : latest)
+					keyframe.records.push_back(offset);
+				// Decoded in file order, like the records were written
+				std::ranges::sort(keyframe.records);
 			}
+			int64_t time;
+			record.GetInteger(&time);
+			cycles.push_back( { time, position });
+			inCycle = true;
+		} else if (inCycle && !entry->second.isReplayOutput)
+			latest[record.GetEntry()] = start;
+	}
+}
+
+bool WPILOGReader::LoadIndex() {
+	std::ifstream stream { GetIndexPath(), std::ios::binary };
+	if (!stream)
+		return false;
+
+	std::string magic(INDEX_MAGIC.size(), '\0');
+	stream.read(magic.data(), magic.size());
+	Fingerprint fingerprint = GetFingerprint(filename);
+	if (magic != INDEX_MAGIC || fingerprint.hash == 0
+			|| ReadFingerprint(stream) != fingerprint)
+		return false;
+
+	std::unordered_map<int, Entry> loadedEntries;
+	for (uint64_t i = Read<uint64_t>(stream); i > 0 && stream; i--) {
+		int id = Read<int32_t>(stream);
+		Entry &entry = loadedEntries[id];
+		entry.type = static_cast<LogTable::LoggableType>(Read<uint8_t>(stream));
+		entry.key = ReadString(stream);
+		entry.customType = ReadString(stream);
+		entry.isTimestamp = "/" + entry.key == LogDataReceiver::TIMESTAMP_KEY;
+		entry.isReplayOutput = entry.key.starts_with("ReplayOutputs");
+	}
+
+	std::vector<Cycle> loadedCycles(Read<uint64_t>(stream));
+	for (Cycle &cycle : loadedCycles) {
+		cycle.timestamp = Read<int64_t>(stream);
+		cycle.offset = Read<uint64_t>(stream);
+	}
+
+	std::vector<Keyframe> loadedKeyframes(Read<uint64_t>(stream));
+	for (Keyframe &keyframe : loadedKeyframes) {
+		keyframe.cycle = Read<uint64_t>(stream);
+		keyframe.records.resize(Read<uint64_t>(stream));
+		for (size_t &offset : keyframe.records)
+			offset = Read<uint64_t>(stream);
+	}
+
+	if (!stream)
+		return false;
+	// Seek needs a keyframe at the first cycle, and would decode offsets
+	// past the end as records
+	if (!loadedCycles.empty()
+			&& (loadedKeyframes.empty() || loadedKeyframes.front().cycle != 0))
+		return false;
+	for (const Cycle &cycle : loadedCycles) {
+		if (cycle.offset > fingerprint.size)
+			return false;
+	}
+	for (const Keyframe &keyframe : loadedKeyframes) {
+		if (keyframe.cycle >= loadedCycles.size())
+			return false;
+		for (size_t offset : keyframe.records) {
+			if (offset >= fingerprint.size)
+				return false;
 		}
 	}
-	return *iterator < reader->end() && !readError;
+	entries.merge(loadedEntries);
+	cycles = std::move(loadedCycles);
+	keyframes = std::move(loadedKeyframes);
+	return true;
+}
+
+void WPILOGReader::SaveIndex() const {
+	std::ofstream stream { GetIndexPath(), std::ios::binary | std::ios::trunc };
+	if (!stream)
+		return;
+
+	stream.write(INDEX_MAGIC.data(), INDEX_MAGIC.size());
+	WriteFingerprint(stream, GetFingerprint(filename));
+
+	Write<uint64_t>(stream, entries.size());
+	for (const auto &[id, entry] : entries) {
+		Write<int32_t>(stream, id);
+		Write<uint8_t>(stream, static_cast<uint8_t>(entry.type));
+		WriteString(stream, entry.key);
+		WriteString(stream, entry.customType);
+	}
+
+	Write<uint64_t>(stream, cycles.size());
+	for (const Cycle &cycle : cycles) {
+		Write<int64_t>(stream, cycle.timestamp);
+		Write<uint64_t>(stream, cycle.offset);
+	}
+
+	Write<uint64_t>(stream, keyframes.size());
+	for (const Keyframe &keyframe : keyframes) {
+		Write<uint64_t>(stream, keyframe.cycle);
+		Write<uint64_t>(stream, keyframe.records.size());
+		for (size_t offset : keyframe.records)
+			Write<uint64_t>(stream, offset);
+	}
 }
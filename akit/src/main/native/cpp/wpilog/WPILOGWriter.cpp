@@ -59,11 +59,13 @@ void WPILOGWriter::Start() {
 	timestampID =
 			log->Start(TIMESTAMP_KEY,
 					LogTable::WPILOG_TYPES[static_cast<int>(LogTable::LoggableType::Integer)]);
-	lastTable = LogTable { 0_s };
+	lastRevision = 0;
 }
 
 void WPILOGWriter::End() {
-	log.release();
+	// Flushes and closes the file
+	isOpen = false;
+	log.reset();
 
 	bool shouldOpen = false;
 	switch (openBehavior) {
@@ -146,5 +148,132 @@ void WPILOGWriter::PutTable(LogTable &table) {
 				::tolower);
 
 		std::string newFilename = "akit_";
+		if (!logDate)
+			newFilename += randomIdentifier;
+		else {
+			std::time_t time = std::chrono::system_clock::to_time_t(*logDate);
+			std::ostringstream date;
+			date << std::put_time(std::localtime(&time), "%y-%m-%d_%H-%M-%S");
+			newFilename += date.str();
+		}
+		if (!eventName.empty())
+			newFilename += "_" + eventName;
+		if (!logMatchText.empty())
+			newFilename += "_" + logMatchText;
+		newFilename += ".wpilog";
+		if (newFilename != filename) {
+			fs::path logPath = fs::path { folder } / newFilename;
+			std::cout << "[AdvantageKit] Renaming log to \"" << logPath.string()
+					<< "\"\n";
+			std::error_code code;
+			fs::rename(fs::path { folder } / filename, logPath, code);
+			filename = newFilename;
+		}
+	}
+
+	int64_t timestamp = units::microsecond_t { table.GetTimestamp() }.value();
+	log->AppendInteger(timestampID, timestamp, timestamp);
+
+	// Samples are written at their own timestamps. A field whose value is
+	// still its last sample's is not written again at the cycle timestamp,
+	// which would record it before it was sampled. Values written after the
+	// merge differ from the sample, so they are still written.
+	table.ForEachSample([&](const LogTable::Sample &sample) {
+		Append(sample.id, sample.value,
+				units::microsecond_t { sample.timestamp }.value());
+		if (!lastSamples[sample.id])
+			sampledIds.push_back(sample.id);
+		lastSamples[sample.id] = &sample.value;
+	});
+
+	table.ForEachChange(lastRevision,
+			[&](KeyRegistry::FieldId id, const LogTable::LogValue &value) {
+		if (id >= lastSamples.size() || !lastSamples[id]
+				|| *lastSamples[id] != value)
+			Append(id, value, timestamp);
+	});
+	for (KeyRegistry::FieldId id : sampledIds)
+		lastSamples[id] = nullptr;
+	sampledIds.clear();
+
+	log->Flush();
+	lastRevision = table.GetRevision();
+}
+
+void WPILOGWriter::Append(KeyRegistry::FieldId id,
+		const LogTable::LogValue &value, int64_t timestamp) {
+	if (id >= entryIDs.size()) {
+		entryIDs.resize(KeyRegistry::Size());
+		entryUnits.resize(KeyRegistry::Size());
+		lastSamples.resize(KeyRegistry::Size());
+	}
+
+	bool hasUnit = value.unit != StringRegistry::EMPTY;
+	if (!entryIDs[id]) {
+		std::string metadata =
+				hasUnit ?
+						UnitMetadata(value.GetUnitStr()) :
+						std::string { WPILOGConstants::EXTRA_METADATA };
+		entryIDs[id] = log->Start(KeyRegistry::GetKey(id), value.GetWPILOGType(),
+				metadata, timestamp);
+		entryUnits[id] = value.unit;
+	}
+
+	int entry = *entryIDs[id];
+	if (hasUnit && value.unit != entryUnits[id]) {
+		log->SetMetadata(entry, UnitMetadata(value.GetUnitStr()), timestamp);
+		entryUnits[id] = value.unit;
+	}
+
+	switch (value.type) {
+	case LogTable::LoggableType::Raw: {
+		auto raw = value.GetRaw();
+		log->AppendRaw(entry, std::span {
+				reinterpret_cast<const uint8_t*>(raw.data()), raw.size() },
+				timestamp);
+		break;
 	}
+	case LogTable::LoggableType::Boolean:
+		log->AppendBoolean(entry, value.GetBoolean(), timestamp);
+		break;
+	case LogTable::LoggableType::Integer:
+		log->AppendInteger(entry, value.GetInteger(), timestamp);
+		break;
+	case LogTable::LoggableType::Float:
+		log->AppendFloat(entry, value.GetFloat(), timestamp);
+		break;
+	case LogTable::LoggableType::Double:
+		log->AppendDouble(entry, value.GetDouble(), timestamp);
+		break;
+	case LogTable::LoggableType::String:
+		log->AppendString(entry, value.GetString(), timestamp);
+		break;
+	case LogTable::LoggableType::BooleanArray: {
+		auto booleans = value.GetBooleanArray();
+		std::vector<int> ints { booleans.begin(), booleans.end() };
+		log->AppendBooleanArray(entry, ints, timestamp);
+		break;
+	}
+	case LogTable::LoggableType::IntegerArray: {
+		auto integers = value.GetIntegerArray();
+		std::vector<int64_t> values { integers.begin(), integers.end() };
+		log->AppendIntegerArray(entry, values, timestamp);
+		break;
+	}
+	case LogTable::LoggableType::FloatArray:
+		log->AppendFloatArray(entry, value.GetFloatArray(), timestamp);
+		break;
+	case LogTable::LoggableType::DoubleArray:
+		log->AppendDoubleArray(entry, value.GetDoubleArray(), timestamp);
+		break;
+	case LogTable::LoggableType::StringArray:
+		log->AppendStringArray(entry, value.GetStringArray(), timestamp);
+		break;
+	}
+}
+
+std::string WPILOGWriter::UnitMetadata(const std::string &unit) {
+	std::string metadata { WPILOGConstants::ENTRY_METADATA_UNITS };
+	metadata.replace(metadata.find("$UNITSTR"), 8, unit);
+	return metadata;
 }
@@ -0,0 +1,95 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#pragma once
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "akit/LogTable.h"
+
+namespace akit {
+
+// Logs registered getters every cycle, the C++ counterpart of the Java
+// @AutoLogOutput annotation. Each key is resolved to a field handle when it
+// is registered, so polling only calls the getters and writes the handles.
+// Registered objects must outlive their registration or be unregistered.
+class AutoLogOutputManager {
+public:
+	using EntryId = size_t;
+
+	explicit AutoLogOutputManager(LogTable &&table) : table {
+			std::move(table) } {
+	}
+
+	// Logs the result of getter() at key
+	template<typename F>
+	EntryId Register(std::string key, F getter) {
+		using R = std::decay_t<std::invoke_result_t<F&>>;
+		// C strings are logged as strings, not through the bool conversion
+		using T = std::conditional_t<std::is_convertible_v<R, std::string>,
+				std::string, R>;
+		entries.push_back(
+				std::make_unique < GetterEntry < T, F
+						>> (table.Register<T>(std::move(key)), std::move(getter)));
+		return entries.size() - 1;
+	}
+
+	// Logs the result of (object.*getter)() at key
+	template<typename C, typename R>
+	EntryId Register(std::string key, const C &object, R (C::*getter)() const) {
+		return Register(std::move(key), [&object, getter] {
+			return (object.*getter)();
+		});
+	}
+
+	// Logs object.*field at key
+	template<typename C, typename R>
+	requires (!std::is_function_v<R>)
+	EntryId Register(std::string key, const C &object, R C::*field) {
+		return Register(std::move(key), [&object, field]() -> const R& {
+			return object.*field;
+		});
+	}
+
+	void Unregister(EntryId id) {
+		entries.at(id).reset();
+	}
+
+	// Writes every registered getter's current value
+	void Poll() {
+		for (auto &entry : entries) {
+			if (entry)
+				entry->Log();
+		}
+	}
+
+private:
+	struct Entry {
+		virtual ~Entry() = default;
+		virtual void Log() = 0;
+	};
+
+	template<typename T, typename F>
+	struct GetterEntry: Entry {
+		GetterEntry(LogTable::Handle<T> handle, F getter) : handle {
+				std::move(handle) }, getter { std::move(getter) } {
+		}
+
+		void Log() override {
+			handle.Set(getter());
+		}
+
+		LogTable::Handle<T> handle;
+		F getter;
+	};
+
+	LogTable table;
+	std::vector<std::unique_ptr<Entry>> entries;
+};
+
+}
@@ -6,11 +6,16 @@
 // at the root directory of this project.
 
 #pragma once
+#include <array>
+#include <atomic>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <sstream>
 #include <iostream>
 #include <mutex>
+#include <vector>
 #include <readerwritercircularbuffer.h>
 
 namespace akit {
@@ -21,8 +26,35 @@ public:
 	virtual std::string GetNewData() = 0;
 };
 
+// Console output captured since the last read, holding at most capacity
+// bytes. Writers may be on any thread; once full, the oldest output is
+// dropped.
+class ConsoleRingBuffer {
+public:
+	explicit ConsoleRingBuffer(size_t capacity) : buffer(capacity) {
+	}
+
+	void Write(std::string_view data);
+
+	// Returns the output written since the last call, and how many bytes
+	// were dropped before it
+	std::string Read(size_t *droppedBytes = nullptr);
+
+private:
+	std::mutex mutex;
+	std::vector<char> buffer;
+	size_t start = 0;
+	size_t size = 0;
+	size_t dropped = 0;
+};
+
+// Captures stdout and stderr, including printf and cout, by redirecting
+// them into a pipe that a reader thread copies to the original streams.
+// Where a pipe cannot be set up, only cout and cerr are captured.
 class SimulatorConsoleSource: public ConsoleSource {
 public:
+	static constexpr size_t CAPTURE_CAPACITY = 1 << 20;
+
 	SimulatorConsoleSource();
 	~SimulatorConsoleSource() override;
 
@@ -31,29 +63,37 @@ public:
 private:
 	class SplitBuffer: public std::streambuf {
 	public:
-		SplitBuffer(std::streambuf *original, std::ostringstream &capture) : original {
+		SplitBuffer(std::streambuf *original, ConsoleRingBuffer &capture) : original {
 				original }, capture { capture } {
 		}
 
 	protected:
 		int overflow(int c) override;
+		std::streamsize xsputn(const char *s, std::streamsize n) override;
+		int sync() override;
 
 	private:
 		std::streambuf *original;
-		std::ostringstream &capture;
+		ConsoleRingBuffer &capture;
 	};
 
-	std::streambuf *originalCout;
-	std::streambuf *originalCerr;
+	bool StartPipeCapture();
+	void StopPipeCapture();
+	void ReadPipe();
 
-	std::ostringstream capturedCout;
-	std::ostringstream capturedCerr;
+	ConsoleRingBuffer captured { CAPTURE_CAPACITY };
 
-	SplitBuffer splitCout { originalCout, capturedCout };
-	SplitBuffer splitCerr { originalCerr, capturedCerr };
+	// Pipe capture, for stdout then stderr
+	std::array<int, 2> pipeReads { -1, -1 };
+	std::array<int, 2> originalFds { -1, -1 };
+	std::atomic<bool> reading = false;
+	std::thread reader;
 
-	size_t coutPos = 0;
-	size_t cerrPos = 0;
+	// Stream capture
+	std::streambuf *originalCout = nullptr;
+	std::streambuf *originalCerr = nullptr;
+	std::unique_ptr<SplitBuffer> splitCout;
+	std::unique_ptr<SplitBuffer> splitCerr;
 };
 
 class RoboRIOConsoleSource: public ConsoleSource {
@@ -0,0 +1,68 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#pragma once
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace akit {
+
+// Monotonic arena holding the payloads of one queued cycle. Arenas are
+// pooled: once the last reference to an arena is released (after the
+// receivers have finished with its cycle), it is reset and reused. Its
+// buffer grows to fit the largest cycle seen, so steady-state cycles do not
+// touch the general heap.
+class CycleArena: public std::pmr::memory_resource {
+public:
+	struct PoolStats {
+		size_t lastCycleBytes = 0;
+		size_t highWaterBytes = 0;
+		size_t totalArenas = 0;
+		size_t idleArenas = 0;
+	};
+
+	static std::shared_ptr<CycleArena> Acquire();
+
+	static PoolStats GetPoolStats();
+
+	size_t GetBytesAllocated() const {
+		return bytesAllocated;
+	}
+
+protected:
+	void* do_allocate(size_t bytes, size_t alignment) override;
+
+	void do_deallocate(void*, size_t, size_t) override {
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource &other) const noexcept
+			override {
+		return this == &other;
+	}
+
+private:
+	static constexpr size_t INITIAL_BUFFER_SIZE = 64 * 1024;
+
+	CycleArena();
+
+	void Reset();
+
+	void Recycle();
+
+	std::vector<std::byte> buffer;
+	std::optional<std::pmr::monotonic_buffer_resource> resource;
+	size_t bytesAllocated = 0;
+
+	static std::mutex poolMutex;
+	static std::vector<std::unique_ptr<CycleArena>> idleArenas;
+	static PoolStats stats;
+};
+
+}
@@ -0,0 +1,48 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace akit {
+
+// Assigns each full field path (e.g. "/RealOutputs/Drive/LeftVelocity") a
+// stable integer ID the first time it is seen. IDs are dense and never
+// reused, so tables and receivers can index by them instead of hashing the
+// path every cycle.
+class KeyRegistry {
+public:
+	using FieldId = uint32_t;
+
+	static FieldId GetId(std::string_view key);
+
+	static std::optional<FieldId> FindId(std::string_view key);
+
+	static const std::string& GetKey(FieldId id);
+
+	static size_t Size();
+
+private:
+	struct KeyHash {
+		using is_transparent = void;
+		size_t operator()(std::string_view key) const {
+			return std::hash<std::string_view> { }(key);
+		}
+	};
+
+	static std::shared_mutex mutex;
+	static std::unordered_map<std::string, FieldId, KeyHash, std::equal_to<>> ids;
+	static std::deque<std::string> keys;
+};
+
+}
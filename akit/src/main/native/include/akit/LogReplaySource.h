@@ -17,6 +17,13 @@ public:
 	virtual ~LogReplaySource() = default;
 
 	virtual bool UpdateTable(LogTable &table) = 0;
+
+	// Moves replay to the last cycle at or before timestamp. The next
+	// UpdateTable writes the state of every field at that cycle. Returns
+	// false if the source cannot seek.
+	virtual bool Seek(units::second_t timestamp) {
+		return false;
+	}
 };
 
 }
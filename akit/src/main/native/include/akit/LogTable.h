@@ -6,12 +6,19 @@
 // at the root directory of this project.
 
 #pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
-#include <any>
+#include <variant>
+#include <memory_resource>
 #include <vector>
 #include <memory>
-#include <unordered_set>
+#include <optional>
+#include <span>
+#include <array>
+#include <stdexcept>
 
 #include <wpi/array.h>
 #include <wpi/struct/Struct.h>
@@ -21,13 +28,16 @@
 #include <units/angle.h>
 #include <units/time.h>
 
+#include "akit/CycleArena.h"
+#include "akit/KeyRegistry.h"
+#include "akit/StringRegistry.h"
 #include "akit/inputs/LoggableInputs.h"
 
 namespace akit {
 
 class LogTable {
 public:
-	enum class LoggableType {
+	enum class LoggableType : uint8_t {
 		Raw,
 		Boolean,
 		Integer,
@@ -52,24 +62,40 @@ public:
 	class LogValue {
 	public:
 		LoggableType type;
-		std::string customTypeStr;
-		std::string unitStr;
-
-		LogValue(std::vector<std::byte> value, std::string typeStr);
-		LogValue(bool value, std::string typeStr);
-		LogValue(long value, std::string typeStr);
-		LogValue(float value, std::string typeStr, std::string unitStr = "");
-		LogValue(double value, std::string typeStr, std::string unitStr = "");
-		LogValue(std::string value, std::string typeStr);
-		LogValue(std::vector<bool> value, std::string typeStr);
-		LogValue(std::vector<long> value, std::string typeStr);
-		LogValue(std::vector<float> value, std::string typeStr);
-		LogValue(std::vector<double> value, std::string typeStr);
-		LogValue(std::vector<std::string> value, std::string typeStr);
+		// Interned through StringRegistry, so comparing them is an integer
+		// compare
+		StringRegistry::StringId customType = StringRegistry::EMPTY;
+		StringRegistry::StringId unit = StringRegistry::EMPTY;
+
+		LogValue(std::span<const std::byte> value, std::string_view typeStr);
+		LogValue(bool value, std::string_view typeStr);
+		LogValue(long value, std::string_view typeStr);
+		LogValue(float value, std::string_view typeStr,
+				std::string_view unitStr = "");
+		LogValue(double value, std::string_view typeStr,
+				std::string_view unitStr = "");
+		LogValue(std::string value, std::string_view typeStr);
+		LogValue(std::vector<bool> value, std::string_view typeStr);
+		LogValue(std::vector<long> value, std::string_view typeStr);
+		LogValue(std::vector<float> value, std::string_view typeStr);
+		LogValue(std::vector<double> value, std::string_view typeStr);
+		LogValue(std::vector<std::string> value, std::string_view typeStr);
+
+		// Copies other, allocating its payload from resource
+		LogValue(const LogValue &other, std::pmr::memory_resource *resource);
+
+		LogValue(const LogValue&) = default;
+		LogValue(LogValue&&) = default;
+		LogValue& operator=(const LogValue&) = default;
+		LogValue& operator=(LogValue&&) = default;
 
 		std::vector<std::byte> GetRaw(
 				std::vector<std::byte> defaultValue = { }) const;
 
+		// Views the raw payload without copying it, or is empty if this is not
+		// a raw value
+		std::span<const std::byte> GetRawView() const;
+
 		bool GetBoolean(bool defaultValue = false) const;
 
 		long GetInteger(long defaultValue = 0) const;
@@ -95,6 +121,10 @@ public:
 		std::vector<std::string> GetStringArray(
 				std::vector<std::string> defaultValue = { }) const;
 
+		const std::string& GetCustomTypeStr() const;
+
+		const std::string& GetUnitStr() const;
+
 		std::string GetWPILOGType() const;
 
 		std::string GetNT4Type() const;
@@ -102,27 +132,198 @@ public:
 		bool operator==(const LogValue &other) const;
 
 	private:
-		std::any value;
+		// Alternatives are ordered to match LoggableType. Scalars are stored
+		// inline and short strings fit in the string small buffer, so neither
+		// allocates on Put. Heap payloads use polymorphic allocators so queued
+		// cycles can be copied into a CycleArena.
+		using Payload = std::variant<std::pmr::vector<std::byte>, bool, long,
+				float, double, std::pmr::string, std::pmr::vector<bool>,
+				std::pmr::vector<long>, std::pmr::vector<float>,
+				std::pmr::vector<double>, std::pmr::vector<std::pmr::string>>;
+
+		Payload value;
+	};
+
+	// A value written at its own timestamp rather than the cycle's, e.g. by
+	// a thread other than the logging thread
+	struct Sample {
+		units::second_t timestamp;
+		KeyRegistry::FieldId id;
+		LogValue value;
 	};
 
 	LogTable(units::second_t timestamp) : LogTable { "/", 0, std::make_shared
-			< units::second_t > (0), { } } {
+			< Storage > (timestamp) } {
+	}
+
+	// Copies are independent of the original table, including copies of a
+	// subtable (which copy the full table they view). Chunks are shared
+	// until either table writes to them.
+	LogTable(const LogTable &other) : LogTable { other.prefix, other.depth,
+			std::make_shared < Storage > (*other.storage) } {
+	}
+
+	LogTable& operator=(const LogTable &other) {
+		prefix = other.prefix;
+		depth = other.depth;
+		storage = std::make_shared < Storage > (*other.storage);
+		return *this;
 	}
 
+	LogTable(LogTable&&) = default;
+	LogTable& operator=(LogTable&&) = default;
+
+	// The timestamp is atomic so it can be read from any thread, e.g. by
+	// Logger::GetTimestamp, without locking
 	inline void SetTimestamp(units::second_t timestamp) {
-		*this->timestamp = timestamp;
+		storage->timestamp.store(timestamp.value(), std::memory_order_release);
 	}
 
-	inline units::second_t GetTimestamp() {
-		return *this->timestamp;
+	inline units::second_t GetTimestamp() const {
+		return units::second_t { storage->timestamp.load(
+				std::memory_order_acquire) };
 	}
 
+	// Subtables are views that share storage with this table, so creating
+	// one does not copy any fields and writes to it land in this table
 	inline LogTable GetSubtable(std::string tableName) {
-		return LogTable { prefix + tableName + "/", *this };
+		return LogTable { prefix + tableName + "/", depth + 1, storage };
 	}
 
+	// Returns an immutable view of the full table. Chunks not written since
+	// the previous snapshot are shared with it, and written chunks are copied
+	// into arena, so the cost is proportional to the fields that changed. A
+	// chunk is moved to the heap the first time it is shared, so arena is
+	// released once this snapshot and its copies are.
+	LogTable Snapshot(std::shared_ptr<CycleArena> arena);
+
+	// Copies every field into a map. ForEach visits the same fields without
+	// allocating.
 	std::unordered_map<std::string, LogValue> GetAll(bool subtableOnly);
 
+	inline const LogValue* Find(KeyRegistry::FieldId id) const {
+		const auto &chunks = storage->chunks;
+		size_t index = id / CHUNK_SIZE;
+		if (index >= chunks.size() || !chunks[index])
+			return nullptr;
+		const auto &value = chunks[index]->values[id % CHUNK_SIZE];
+		return value ? &*value : nullptr;
+	}
+
+	// Calls function(id, value) for every field in the table, in ID order
+	template<typename F>
+	void ForEach(F &&function) const {
+		ForEachChange(0, std::forward<F>(function));
+	}
+
+	// Calls function(key, value) for every field in the table, in ID order.
+	// With subtableOnly, only fields under this table's prefix are visited and
+	// keys are relative to it. Keys view the registry's strings, so nothing is
+	// copied.
+	template<typename F>
+	void ForEach(bool subtableOnly, F &&function) const {
+		ForEach([&](KeyRegistry::FieldId id, const LogValue &value) {
+			std::string_view key = KeyRegistry::GetKey(id);
+			if (!subtableOnly)
+				function(key, value);
+			else if (key.starts_with(prefix))
+				function(key.substr(prefix.size()), value);
+		});
+	}
+
+	// Revision of the current cycle. Fields written with a different value
+	// are tagged with it, and it advances each time a snapshot is taken.
+	inline uint64_t GetRevision() const {
+		return storage->revision;
+	}
+
+	// Writes the sample's value and keeps the sample, so receivers can log
+	// every sample at its own timestamp rather than only the last value of
+	// the cycle. Samples move to the next snapshot. Like Put, samples that do
+	// not change the value are ignored.
+	void AddSample(Sample sample);
+
+	// Calls function(sample) for each sample added before this snapshot was
+	// taken, in the order they were added
+	template<typename F>
+	void ForEachSample(F &&function) const {
+		if (storage->samples) {
+			for (const Sample &sample : *storage->samples)
+				function(sample);
+		}
+	}
+
+	// Calls function(id, value) for every field changed after sinceRevision,
+	// in ID order. Receivers pass the revision of the last table they saw.
+	template<typename F>
+	void ForEachChange(uint64_t sinceRevision, F &&function) const {
+		const auto &chunks = storage->chunks;
+		for (size_t index = 0; index < chunks.size(); index++) {
+			if (!chunks[index] || chunks[index]->revision <= sinceRevision)
+				continue;
+			const Chunk &chunk = *chunks[index];
+			for (size_t i = 0; i < CHUNK_SIZE; i++) {
+				if (chunk.values[i] && chunk.revisions[i] > sinceRevision)
+					function(
+							static_cast<KeyRegistry::FieldId>(index * CHUNK_SIZE
+									+ i), *chunk.values[i]);
+			}
+		}
+	}
+
+	// Writes every field changed in other after sinceRevision to this table,
+	// e.g. to apply a cycle that was built in another table
+	void ApplyChanges(const LogTable &other, uint64_t sinceRevision);
+
+	// Removes a field, e.g. one a replay source no longer has after seeking.
+	// Receivers see no change for it, so the last value stays in their logs.
+	void Remove(KeyRegistry::FieldId id);
+
+	template<typename T>
+	class Handle;
+
+	// Registers a field for writes on a hot path. The key is resolved once,
+	// and the handle writes to the same storage as this table.
+	template<typename T>
+	Handle<T> Register(std::string key) {
+		if constexpr (wpi::StructSerializable<T> && (!std::is_arithmetic_v<T>))
+			AddStructSchema<T>();
+		return Handle<T> { LogTable { prefix, depth, storage }, std::move(key) };
+	}
+
+	inline const std::string& GetPrefix() const {
+		return prefix;
+	}
+
+	// Resolves key under this table's prefix. The ID is valid for any table
+	// with the same prefix, so callers that log a fixed set of fields can
+	// resolve them once and use PutField and GetField.
+	KeyRegistry::FieldId GetFieldId(std::string_view key) const;
+
+	// Writes value to a field resolved by GetFieldId, converting it the same
+	// way Put would
+	template<typename T>
+	void PutField(KeyRegistry::FieldId id, const T &value) {
+		if constexpr (wpi::StructSerializable<T> && !std::is_arithmetic_v<T>)
+			AddStructSchema<T>();
+		Put(id, MakeValue(value));
+	}
+
+	template<typename T>
+	void PutField(KeyRegistry::FieldId id, const std::vector<T> &values) {
+		if constexpr (wpi::StructSerializable<T> && !std::is_arithmetic_v<T>)
+			AddStructSchema<T>();
+		Put(id, MakeValue(values));
+	}
+
+	// Reads a field resolved by GetFieldId, or returns defaultValue if it is
+	// missing or has a different type
+	template<typename T>
+	T GetField(KeyRegistry::FieldId id, T defaultValue) const {
+		const LogValue *value = Find(id);
+		return value ? ReadValue(*value, std::move(defaultValue)) : defaultValue;
+	}
+
 	void Put(std::string key, LogValue value);
 
 	template<typename T>
@@ -131,19 +332,25 @@ public:
 	}
 
 	template<typename T>
+	requires (!wpi::StructSerializable<T> || std::is_arithmetic_v<T>)
 	inline void Put(std::string key, std::vector<T> value) {
 		Put(key, LogValue { value, "" });
 	}
 
+	// Rows are logged to "key/0", "key/1", ... with the row count in
+	// "key/length". Row field IDs are cached per key.
 	template<typename T>
-	void Put(std::string key, std::vector<std::vector<T>> value) {
-		Put(key + "/length", static_cast<long>(value.size()));
+	void Put(std::string key, const std::vector<std::vector<T>> &value) {
+		if constexpr (wpi::StructSerializable<T> && (!std::is_arithmetic_v<T>))
+			AddStructSchema<T>();
+		const NestedKeys &keys = GetNestedKeys(GetFieldId(key), value.size());
+		Put(keys.length, LogValue { static_cast<long>(value.size()), "" });
 		for (size_t i = 0; i < value.size(); i++)
-			Put(key + "/" + std::to_string(i), value[i]);
+			Put(keys.rows[i], MakeValue(value[i]));
 	}
 
 	template <typename T>
-	requires std::is_integral_v<T>
+	requires std::is_integral_v<T> && (!std::is_same_v<T, bool>)
 	void Put(std::string key, T value) {
 		Put(key, LogValue { static_cast<long>(value), "" });
 	}
@@ -151,7 +358,7 @@ public:
 	template <typename E>
 	requires std::is_enum_v<E>
 	inline void Put(std::string key, E value) {
-		Put(key, LogValue { magic_enum::enum_name(value), "" });
+		Put(key, LogValue { std::string { magic_enum::enum_name(value) }, "" });
 	}
 
 	template <typename E>
@@ -166,7 +373,7 @@ public:
 	template <typename U>
 	requires units::traits::is_unit_t_v<U>
 	inline void Put(std::string key, U value) {
-		Put(key, LogValue { value.value(), "", value.name() });
+		Put(key, MakeValue(value));
 	}
 
 	template <typename S>
@@ -193,51 +400,67 @@ public:
 	requires wpi::StructSerializable<T> && (!std::is_arithmetic_v<T>)
 	void Put(std::string key, T value) {
 		AddStructSchema<T>();
-		std::array<std::byte, wpi::GetStructSize<T>()> buffer;
-		wpi::PackStruct < T > (buffer);
-		Put(key, LogValue {buffer, wpi::GetStructTypeString<T>()});
+		Put(key, MakeValue(value));
+	}
+
+	// Struct arrays are packed into one contiguous buffer
+	template <typename T, size_t Extent>
+	requires wpi::StructSerializable<std::remove_cv_t<T>> && (!std::is_arithmetic_v<T>)
+	void Put(std::string key, std::span<T, Extent> values) {
+		using Type = std::remove_cv_t<T>;
+		AddStructSchema<Type>();
+		Put(key, MakeStructArrayValue(std::span<const Type> {values}));
 	}
 
 	template <typename T>
 	requires wpi::StructSerializable<T> && (!std::is_arithmetic_v<T>)
-	void Put(std::string key, std::initializer_list<T> values) {
-		AddStructSchema<T>();
-		std::vector < std::byte
-		> buffer {values.size() * wpi::GetStructSize<T>()};
-		int i = 0;
-		for (const T &value : values)
-		wpi::PackStruct(
-				std::span < std::byte
-				> (buffer).subspan(i++ * wpi::GetStructSize<T>()),
-				value);
-		Put(key, LogValue {buffer, wpi::GetStructTypeString<T>() + "[]"});
+	inline void Put(std::string key, const std::vector<T> &values) {
+		Put(key, std::span {values});
+	}
+
+	template <typename T, size_t N>
+	requires wpi::StructSerializable<T> && (!std::is_arithmetic_v<T>)
+	inline void Put(std::string key, const std::array<T, N> &values) {
+		Put(key, std::span {values});
+	}
+
+	template <typename T>
+	requires wpi::StructSerializable<T> && (!std::is_arithmetic_v<T>)
+	inline void Put(std::string key, std::initializer_list<T> values) {
+		Put(key, std::span {values.begin(), values.size()});
 	}
 
 	inline LogValue Get(std::string key) {
-		return data.at(prefix + key);
+		const LogValue *value = Find(key);
+		if (!value)
+			throw std::out_of_range { "No field \"" + prefix + key + "\"" };
+		return *value;
 	}
 
 	template<typename T>
 	std::vector<std::vector<T>> Get(std::string key,
 			std::vector<std::vector<T>> defaultValue) {
-		if (data.contains(prefix + key + "/length")) {
-			std::vector < std::vector
-					< T
-							>> value { static_cast<size_t>(Get(key + "/length",
-									0)) };
-			for (size_t i = 0; i < value.size(); i++)
-				value[i] = Get(key, +"/", std::to_string(i),
-						std::vector<T> { });
-			return value;
-		} else
+		// Interned even if only the rows were written, as by a replay source
+		KeyRegistry::FieldId base = GetFieldId(key);
+		const LogValue *length = Find(GetNestedKeys(base, 0).length);
+		if (!length)
 			return defaultValue;
+
+		size_t rowCount = std::max(length->GetInteger(), 0L);
+		const NestedKeys &keys = GetNestedKeys(base, rowCount);
+		std::vector < std::vector < T >> value(rowCount);
+		for (size_t i = 0; i < value.size(); i++) {
+			if (const LogValue *row = Find(keys.rows[i]))
+				value[i] = ReadArray<T>(*row);
+		}
+		return value;
 	}
 
 	template <typename T>
 	requires std::is_integral_v<T>
 	T Get(std::string key, T defaultValue) {
-		if (data.contains(prefix + key))
-			return static_cast<T>(Get(key).GetInteger(defaultValue));
+		if (const LogValue *value = Find(key))
+			return static_cast<T>(value->GetInteger(defaultValue));
 		else
 			return defaultValue;
 	}
@@ -245,10 +468,10 @@ public:
 	template <typename T>
 	requires std::is_integral_v<T>
 	std::vector<T> Get(std::string key, std::vector<T> defaultValue) {
-		if (data.contains(prefix + key)) {
-			std::vector<long> value = Get(key).GetIntegerArray(
+		if (const LogValue *value = Find(key)) {
+			std::vector<long> integers = value->GetIntegerArray(
 					{ defaultValue.begin(), defaultValue.end() });
-			return {value.begin(), value.end()};
+			return {integers.begin(), integers.end()};
 		} else
 			return defaultValue;
 	}
@@ -272,9 +495,9 @@ public:
 	template <typename T>
 	requires std::is_enum_v<T>
 	T Get(std::string key, T defaultValue) {
-		if (data.contains(prefix + key))
+		if (const LogValue *value = Find(key))
 			return magic_enum::enum_cast(
-					Get(key).GetString(magic_enum::enum_name(defaultValue)));
+					value->GetString(magic_enum::enum_name(defaultValue)));
 		else
 			return defaultValue;
 	}
@@ -282,8 +505,8 @@ public:
 	template <typename T>
 	requires std::is_enum_v<T>
 	std::vector<T> Get(std::string key, std::vector<T> defaultValue) {
-		if (data.contains(prefix + key)) {
-			std::vector < std::string > names = Get(key).GetStringArray( { });
+		if (const LogValue *value = Find(key)) {
+			std::vector < std::string > names = value->GetStringArray( { });
 			std::vector < T > enums;
 			for (const auto &name : names)
 				enums.emplace_back(magic_enum::enum_cast < T > (name));
@@ -295,11 +518,10 @@ public:
 	template <typename U>
 	requires units::traits::is_unit_t_v<U>
 	U Get(std::string key, U defaultValue) {
-		using BaseUnit = units::unit<std::ratio<1>, units::traits::base_unit_of<typename U::unit_type>>;
-		if (data.contains(prefix + key)) {
-			auto converted = defaultValue.template convert<BaseUnit>();
-			return BaseUnit { Get(key).GetDouble(converted.value()) };
-		} else
+		// Put logs the value in its own unit
+		if (const LogValue *value = Find(key))
+			return U { value->GetDouble(defaultValue.value()) };
+		else
 			return defaultValue;
 	}
 
@@ -311,60 +533,360 @@ public:
 	template <typename T>
 	requires wpi::StructSerializable<T> && (!std::is_arithmetic_v<T>)
 	T Get(std::string key, T defaultValue) {
-		if (data.contains(prefix + key))
-		return wpi::UnpackStruct<T>(Get(key).GetRaw());
-		else return defaultValue;
+		const LogValue *value = Find(key);
+		if (!value)
+		return defaultValue;
+		std::span<const uint8_t> raw = StructBytes(*value);
+		if (raw.size() < wpi::GetStructSize<T>())
+		return defaultValue;
+		return wpi::UnpackStruct<T>(raw.first(wpi::GetStructSize<T>()));
 	}
 
+	// Struct arrays are unpacked straight from the stored buffer
 	template <typename T>
 	requires wpi::StructSerializable<T> && (!std::is_arithmetic_v<T>)
 	std::vector<T> Get(std::string key, std::vector<T> defaultValue) {
-		if (data.contains(prefix + key)) {
-			std::vector<std::byte> buffer = Get(key).GetRaw();
-			std::vector<T> structs {buffer.size() / wpi::GetStructSize<T>()};
-			for (int i = 0; i < structs.size(); i++)
-			wpi::UnpackStructInto(structs.data() + i, std::span<std::byte> {buffer}.subspan(i * wpi::GetStructSize<T>()));
-			return structs;
-		} else return defaultValue;
+		const LogValue *value = Find(key);
+		if (!value)
+		return defaultValue;
+		constexpr size_t size = wpi::GetStructSize<T>();
+		std::span<const uint8_t> raw = StructBytes(*value);
+		std::vector<T> structs;
+		structs.reserve(raw.size() / size);
+		for (size_t offset = 0; offset + size <= raw.size(); offset += size)
+		structs.push_back(wpi::UnpackStruct<T>(raw.subspan(offset, size)));
+		return structs;
+	}
+
+	template <typename T, size_t N>
+	requires wpi::StructSerializable<T> && (!std::is_arithmetic_v<T>)
+	std::array<T, N> Get(std::string key, std::array<T, N> defaultValue) {
+		const LogValue *value = Find(key);
+		constexpr size_t size = wpi::GetStructSize<T>();
+		if (!value || StructBytes(*value).size() != N * size)
+		return defaultValue;
+		std::span<const uint8_t> raw = StructBytes(*value);
+		for (size_t i = 0; i < N; i++)
+		defaultValue[i] = wpi::UnpackStruct<T>(raw.subspan(i * size, size));
+		return defaultValue;
 	}
 
 private:
-	LogTable(std::string prefix, int depth,
-			std::shared_ptr<units::second_t> timestamp,
-			std::unordered_map<std::string, LogValue> data) : prefix { prefix }, depth {
-			depth }, timestamp { timestamp }, data { data } {
+	// Converts and stages writes made off the logging thread
+	friend class SampleStager;
+
+	static constexpr size_t CHUNK_SIZE = 16;
+
+	// Fields are stored in fixed-size chunks indexed by FieldId. Chunks are
+	// shared between copies and snapshots, and are copied before a write if
+	// any other table holds them.
+	struct Chunk {
+		// Declared before values so that it outlives the payloads it holds.
+		// Null for chunks whose payloads are on the heap.
+		std::shared_ptr<CycleArena> arena;
+		std::array<std::optional<LogValue>, CHUNK_SIZE> values;
+		// Revision of the last change to each value, and to any of them
+		std::array<uint64_t, CHUNK_SIZE> revisions { };
+		uint64_t revision = 0;
+	};
+
+	struct Storage {
+		Storage(units::second_t timestamp) : timestamp { timestamp.value() } {
+		}
+
+		Storage(const Storage &other) : timestamp { other.timestamp.load() }, revision {
+				other.revision }, chunks { other.chunks }, samples {
+				other.samples } {
+		}
+
+		std::atomic<double> timestamp;
+		uint64_t revision = 1;
+		std::vector<std::shared_ptr<Chunk>> chunks;
+		// Shared with copies until either adds a sample
+		std::shared_ptr<std::vector<Sample>> samples;
+
+		// Chunks of the previous snapshot. Chunks changed since then have
+		// the current revision.
+		std::vector<std::shared_ptr<Chunk>> snapshotChunks;
+	};
+
+	LogTable(std::string prefix, int depth, std::shared_ptr<Storage> storage) : prefix {
+			std::move(prefix) }, depth { depth }, storage { std::move(storage) } {
+	}
+
+	// Field IDs of a nested array's length and rows
+	struct NestedKeys {
+		KeyRegistry::FieldId length;
+		std::vector<KeyRegistry::FieldId> rows;
+	};
+
+	std::optional<KeyRegistry::FieldId> FindFieldId(std::string_view key) const;
+
+	// Returns the keys for base's nested array, with at least rowCount rows.
+	// Cached per thread and base, so each row key is only built once.
+	static const NestedKeys& GetNestedKeys(KeyRegistry::FieldId base,
+			size_t rowCount);
+
+	const LogValue* Find(std::string_view key) const;
+
+	void Put(KeyRegistry::FieldId id, LogValue value);
+
+	void Set(KeyRegistry::FieldId id, LogValue value);
+
+	// Returns the chunk at index for writing, copying it first if it is
+	// shared or backed by a cycle arena
+	Chunk& GetWritableChunk(size_t index);
+
+	bool WriteAllowed(KeyRegistry::FieldId id, LoggableType type,
+			StringRegistry::StringId customType);
+
+	// Whether Put writes a T to a single field, converted by MakeValue,
+	// rather than to several fields or a subtable
+	template<typename T>
+	static constexpr bool IsFieldValue() {
+		if constexpr (requires { typename T::value_type; }) {
+			using E = typename T::value_type;
+			if constexpr (std::is_same_v<T, std::vector<E>>)
+				return std::is_arithmetic_v<E> || std::is_enum_v<E>
+						|| std::is_same_v<E, std::string>
+						|| std::is_same_v<E, std::byte>
+						|| wpi::StructSerializable<E>;
+		}
+		return std::is_arithmetic_v<T> || std::is_enum_v<T>
+				|| units::traits::is_unit_t_v<T> || std::is_same_v<T, frc::Color>
+				|| std::is_convertible_v<T, std::string>
+				|| wpi::StructSerializable<T>;
+	}
+
+	// Converts a value to how the matching Put overload would log it
+	template<typename T>
+	static LogValue MakeValue(const T &value) {
+		if constexpr (std::is_same_v<T, frc::Color>)
+			return LogValue { value.HexString(), "" };
+		else if constexpr (std::is_convertible_v<T, std::string>
+				&& !std::is_same_v<T, std::string>)
+			return LogValue { std::string { value }, "" };
+		else if constexpr (std::is_enum_v<T>)
+			return LogValue { std::string { magic_enum::enum_name(value) }, "" };
+		else if constexpr (units::traits::is_unit_t_v<T>) {
+			// Unit names depend only on the type
+			static const StringRegistry::StringId unit = StringRegistry::GetId(
+					value.name());
+			LogValue logValue { value.value(), "" };
+			logValue.unit = unit;
+			return logValue;
+		} else if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>)
+			return LogValue { static_cast<long>(value), "" };
+		else if constexpr (wpi::StructSerializable<T>
+				&& !std::is_arithmetic_v<T>) {
+			std::array<uint8_t, wpi::GetStructSize<T>()> buffer;
+			wpi::PackStruct(buffer, value);
+			LogValue logValue { std::as_bytes(std::span { buffer }), "" };
+			logValue.customType = StructTypeId<T>();
+			return logValue;
+		} else
+			return LogValue { value, "" };
+	}
+
+	template<typename T>
+	static LogValue MakeValue(const std::vector<T> &values) {
+		if constexpr (std::is_enum_v<T>) {
+			std::vector < std::string > names;
+			for (T value : values)
+				names.emplace_back(magic_enum::enum_name(value));
+			return LogValue { names, "" };
+		} else if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>)
+			return LogValue { std::vector<long> { values.begin(), values.end() },
+					"" };
+		else if constexpr (wpi::StructSerializable<T>
+				&& !std::is_arithmetic_v<T>)
+			return MakeStructArrayValue(std::span<const T> { values });
+		else
+			return LogValue { values, "" };
+	}
+
+	template<typename T>
+	static LogValue MakeStructArrayValue(std::span<const T> values) {
+		constexpr size_t size = wpi::GetStructSize<T>();
+		// Reused across calls so packing does not allocate
+		thread_local std::vector<uint8_t> buffer;
+		buffer.resize(values.size() * size);
+		for (size_t i = 0; i < values.size(); i++)
+			wpi::PackStruct(std::span { buffer }.subspan(i * size, size),
+					values[i]);
+		LogValue logValue { std::as_bytes(std::span { buffer }), "" };
+		logValue.customType = StructArrayTypeId<T>();
+		return logValue;
+	}
+
+	// Reads an array logged by MakeValue
+	template<typename T>
+	static std::vector<T> ReadArray(const LogValue &value) {
+		if constexpr (std::is_same_v<T, bool>)
+			return value.GetBooleanArray();
+		else if constexpr (std::is_enum_v<T>) {
+			std::vector < T > enums;
+			for (const auto &name : value.GetStringArray())
+				enums.push_back(magic_enum::enum_cast < T > (name).value_or(T { }));
+			return enums;
+		} else if constexpr (std::is_integral_v<T>) {
+			std::vector<long> integers = value.GetIntegerArray();
+			return {integers.begin(), integers.end()};
+		} else if constexpr (std::is_same_v<T, float>)
+			return value.GetFloatArray();
+		else if constexpr (std::is_same_v<T, double>)
+			return value.GetDoubleArray();
+		else if constexpr (std::is_same_v<T, std::string>)
+			return value.GetStringArray();
+		else {
+			constexpr size_t size = wpi::GetStructSize<T>();
+			std::span<const uint8_t> raw = StructBytes(value);
+			std::vector<T> structs;
+			structs.reserve(raw.size() / size);
+			for (size_t offset = 0; offset + size <= raw.size(); offset += size)
+				structs.push_back(wpi::UnpackStruct<T>(raw.subspan(offset, size)));
+			return structs;
+		}
+	}
+
+	// Reads a value logged by MakeValue
+	template<typename T>
+	static T ReadValue(const LogValue &value, T defaultValue) {
+		if constexpr (std::is_same_v<T, bool>)
+			return value.GetBoolean(defaultValue);
+		else if constexpr (std::is_enum_v<T>)
+			return magic_enum::enum_cast < T
+					> (value.GetString()).value_or(defaultValue);
+		else if constexpr (units::traits::is_unit_t_v<T>)
+			return T { value.GetDouble(defaultValue.value()) };
+		else if constexpr (std::is_integral_v<T>)
+			return static_cast<T>(value.GetInteger(defaultValue));
+		else if constexpr (std::is_same_v<T, float>)
+			return value.GetFloat(defaultValue);
+		else if constexpr (std::is_same_v<T, double>)
+			return value.GetDouble(defaultValue);
+		else if constexpr (std::is_same_v<T, std::string>)
+			return value.GetString(std::move(defaultValue));
+		else if constexpr (std::is_same_v<T, frc::Color>)
+			return frc::Color { value.GetString(defaultValue.HexString()) };
+		else {
+			std::span<const uint8_t> raw = StructBytes(value);
+			if (raw.size() < wpi::GetStructSize<T>())
+				return defaultValue;
+			return wpi::UnpackStruct<T>(raw.first(wpi::GetStructSize<T>()));
+		}
+	}
+
+	template<typename T>
+	static std::vector<T> ReadValue(const LogValue &value,
+			std::vector<T> defaultValue) {
+		LoggableType type = LoggableType::Raw;
+		if constexpr (std::is_same_v<T, bool>)
+			type = LoggableType::BooleanArray;
+		else if constexpr (std::is_enum_v<T> || std::is_same_v<T, std::string>)
+			type = LoggableType::StringArray;
+		else if constexpr (std::is_integral_v<T>)
+			type = LoggableType::IntegerArray;
+		else if constexpr (std::is_same_v<T, float>)
+			type = LoggableType::FloatArray;
+		else if constexpr (std::is_same_v<T, double>)
+			type = LoggableType::DoubleArray;
+		return value.type == type ? ReadArray<T>(value) : defaultValue;
+	}
+
+	template <typename T>
+	requires wpi::StructSerializable<T> && (!std::is_arithmetic_v<T>)
+	static const std::string& StructTypeString() {
+		static const std::string typeString = wpi::GetStructTypeString<T>();
+		return typeString;
 	}
 
-	LogTable(std::string prefix, const LogTable &parent) : LogTable { prefix,
-			parent.depth + 1, parent.timestamp, parent.data } {
+	template <typename T>
+	requires wpi::StructSerializable<T> && (!std::is_arithmetic_v<T>)
+	static StringRegistry::StringId StructTypeId() {
+		static const StringRegistry::StringId id = StringRegistry::GetId(
+				StructTypeString<T>());
+		return id;
 	}
 
-	bool WriteAllowed(std::string key, LoggableType type,
-			std::string customTypeStr);
+	template <typename T>
+	requires wpi::StructSerializable<T> && (!std::is_arithmetic_v<T>)
+	static StringRegistry::StringId StructArrayTypeId() {
+		static const StringRegistry::StringId id = StringRegistry::GetId(
+				StructTypeString<T>() + "[]");
+		return id;
+	}
+
+	static inline std::span<const uint8_t> StructBytes(const LogValue &value) {
+		std::span<const std::byte> raw = value.GetRawView();
+		return {reinterpret_cast<const uint8_t*>(raw.data()), raw.size()};
+	}
 
+	// The schema field ID is resolved once per type, so after the first Put
+	// to a table this is a single lookup. Nested schemas are only walked when
+	// the table does not have the schema yet.
 	template <typename T>
 	requires wpi::StructSerializable<T> && (!std::is_arithmetic_v<T>)
 	void AddStructSchema() {
-		std::string typeString = wpi::GetStructTypeString<T>();
-		std::string key = "/.schema/" + typeString;
+		static const KeyRegistry::FieldId id = KeyRegistry::GetId(
+				"/.schema/" + StructTypeString<T>());
 
-		if (data.contains(key))
+		if (Find(id))
 		return;
-		std::unordered_set < std::string > seen;
-		seen.insert(typeString);
-
-		data.emplace(key, LogValue {wpi::GetStructSchemaBytes<T>(),
-					"structschema"});
-		wpi::ForEachStructSchema([&](std::string_view typeString, std::string_view schema) {AddStructSchema(std::string {typeString}, std::string {schema}, seen);});
+		wpi::ForEachStructSchema<T>([&](std::string_view typeString, std::string_view schema) {AddStructSchema(typeString, schema);});
 	}
 
-	void AddStructSchema(std::string typeString, std::string schema,
-			std::unordered_set<std::string> &seen);
+	void AddStructSchema(std::string_view typeString, std::string_view schema);
 
 	std::string prefix;
 	int depth;
-	std::shared_ptr<units::second_t> timestamp;
-	std::unordered_map<std::string, LogValue> data;
+	std::shared_ptr<Storage> storage;
+};
+
+template<typename T>
+class LogTable::Handle {
+public:
+	// Writes value to the field. The field type is only checked on the
+	// first write, and a handle whose type does not match is ignored.
+	void Set(const T &value) {
+		if (!writable)
+			return;
+		LogValue logValue = MakeValue(value);
+		if (!checked) {
+			checked = true;
+			writable = table.WriteAllowed(id, logValue.type,
+					logValue.customType);
+			if (!writable)
+				return;
+		}
+		table.Set(id, std::move(logValue));
+	}
+
+	// Reads the field, for use in FromLog during replay
+	T Get(T defaultValue) const {
+		return table.GetField(id, std::move(defaultValue));
+	}
+
+	inline KeyRegistry::FieldId GetId() const {
+		return id;
+	}
+
+	inline const std::string& GetKey() const {
+		return key;
+	}
+
+private:
+	friend class LogTable;
+
+	Handle(LogTable table, std::string key) : table { std::move(table) }, key {
+			std::move(key) }, id { this->table.GetFieldId(this->key) } {
+	}
+
+	LogTable table;
+	std::string key;
+	KeyRegistry::FieldId id;
+	bool checked = false;
+	bool writable = true;
 };
 
 }
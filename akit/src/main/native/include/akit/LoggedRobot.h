@@ -35,8 +35,8 @@ protected:
 	}
 
 private:
-	// So that Logger can access isLoggedRobot but user cannot modify
-	friend class Logger;
+	// So that the logger can access isLoggedRobot but user cannot modify
+	friend class LoggerContext;
 	static bool isLoggedRobot;
 
 	HAL_NotifierHandle notifier { HAL_InitializeNotifier(nullptr) };
@@ -6,40 +6,77 @@
 // at the root directory of this project.
 
 #pragma once
-#include "akit/LogTable.h"
-#include "akit/ConsoleSource.h"
-#include "akit/networktables/LoggedNetworkInput.h"
-#include "akit/LogReplaySource.h"
-#include "akit/ReceiverThread.h"
-#include "akit/mechanism/LoggedMechanism2d.h"
+#include "akit/LoggerContext.h"
 
 namespace akit {
 
+// Forwards to the calling thread's context (see LoggerContext)
 class Logger {
 public:
-	static void SetReplaySource(std::unique_ptr<LogReplaySource> replaySource);
-	static void AddDataReceiver(std::unique_ptr<LogDataReceiver> dataReceiver);
-	static void RegisterDashboardInput(nt::LoggedNetworkInput&);
+	static LoggerContext& GetContext() {
+		return LoggerContext::GetCurrent();
+	}
+
+	static void SetReplaySource(std::unique_ptr<LogReplaySource> replaySource) {
+		GetContext().SetReplaySource(std::move(replaySource));
+	}
+	static void AddDataReceiver(std::unique_ptr<LogDataReceiver> dataReceiver) {
+		GetContext().AddDataReceiver(std::move(dataReceiver));
+	}
+	static void RegisterDashboardInput(nt::LoggedNetworkInput &input) {
+		GetContext().RegisterDashboardInput(input);
+	}
 	// static void registerURCL();
-	static void RecordMetadata(std::string key, std::string value);
+	static void RecordMetadata(std::string key, std::string value) {
+		GetContext().RecordMetadata(std::move(key), std::move(value));
+	}
+	// Sets what happens to a cycle when a receiver falls behind and its
+	// queue is full. The deadline only applies to BLOCK_WITH_DEADLINE. In
+	// replay the policy is always BLOCK.
+	static void SetReceiverQueuePolicy(ReceiverQueue::Policy policy,
+			units::millisecond_t deadline = 0_ms) {
+		GetContext().SetReceiverQueuePolicy(policy, deadline);
+	}
+	// Outputs and inputs under these prefixes are not written while any
+	// receiver's queue is degraded (see ReceiverQueue::Policy::DEGRADE)
+	static void SetLowPriorityPrefixes(std::vector<std::string> prefixes) {
+		GetContext().SetLowPriorityPrefixes(std::move(prefixes));
+	}
 	static void DisableConsoleCapture() {
-		enableConsole = false;
+		GetContext().DisableConsoleCapture();
 	}
 	static bool HasReplaySource() {
-		return static_cast<bool>(replaySource);
+		return GetContext().HasReplaySource();
+	}
+	// How long End waits for the receivers to write the queued cycles
+	// before dropping the rest and leaving receivers that are still busy to
+	// end in the background. Replay always waits for every cycle.
+	static void SetShutdownDeadline(units::millisecond_t deadline) {
+		GetContext().SetShutdownDeadline(deadline);
+	}
+	static void Start() {
+		GetContext().Start();
+	}
+	// Stops accepting cycles, drains the receivers' queues, and ends the
+	// receivers
+	static ReceiverThread::DrainResult End() {
+		return GetContext().End();
+	}
+	static void PeriodicBeforeUser() {
+		GetContext().PeriodicBeforeUser();
 	}
-	static void Start();
-	static void End();
-	static void PeriodicBeforeUser();
 	static void PeriodicAfterUser(units::millisecond_t userCodeLength,
 			units::millisecond_t periodicBeforeLength,
-			std::string extraConsoleData = "");
+			std::string extraConsoleData = "") {
+		GetContext().PeriodicAfterUser(userCodeLength, periodicBeforeLength,
+				std::move(extraConsoleData));
+	}
 
 	class AdvancedHooks {
 	public:
 		AdvancedHooks() = delete;
 		static void DisableRobotBaseCheck() {
-			checkRobotBase = false;
+			GetContext().DisableRobotBaseCheck();
 		}
 		static void InvokePeriodicBeforeUser() {
 			PeriodicBeforeUser();
@@ -51,47 +88,74 @@ public:
 					extraConsoleData);
 		}
 		static void SetConsoleSource(std::unique_ptr<ConsoleSource> console) {
-			Logger::console = std::move(console);
+			GetContext().SetConsoleSource(std::move(console));
 		}
 	};
 
 	static bool GetReceiverQueueFault() {
-		return receiverQueueFault;
+		return GetContext().GetReceiverQueueFault();
+	}
+	static units::second_t GetTimestamp() {
+		return GetContext().GetTimestamp();
+	}
+	// Runs function on cycles where the cycle count is a multiple of n, so
+	// every caller with the same n runs on the same cycle. Prefer
+	// SchedulePeriodic, which spreads tasks across cycles.
+	static void RunEveryN(size_t n, std::function<void()> function) {
+		GetContext().RunEveryN(n, std::move(function));
+	}
+	// Runs function once every period cycles, after user code, in a phase
+	// balanced against the other scheduled tasks (see PeriodicScheduler)
+	static PeriodicScheduler::TaskId SchedulePeriodic(std::string name,
+			size_t period, std::function<void()> function) {
+		return GetContext().SchedulePeriodic(std::move(name), period,
+				std::move(function));
+	}
+	// ProcessInputs and RecordOutput may be called from any thread. Writes
+	// from threads other than the one running the robot loop are staged
+	// with the time they were made and merged into the cycle at
+	// PeriodicAfterUser, so receivers can log every sample. In replay, such
+	// threads read inputs from the cycle's replayed table.
+	static void ProcessInputs(std::string key, inputs::LoggableInputs &inputs) {
+		GetContext().ProcessInputs(std::move(key), inputs);
 	}
-	static units::second_t GetTimestamp();
-	static void RunEveryN(size_t n, std::function<void()> function);
-	static void ProcessInputs(std::string key, inputs::LoggableInputs &inputs);
 
 	template<typename T>
 	inline static void RecordOutput(std::string key, T value) {
-		if (running)
-			outputTable->Put(key, value);
+		GetContext().RecordOutput(std::move(key), std::move(value));
 	}
 	template<typename T>
 	inline static void RecordOutput(std::string key, std::function<T()> value) {
-		recordOutput(value());
+		RecordOutput(std::move(key), value());
 	}
+	// Call from the robot loop thread only
 	static void RecordOutput(std::string key, mech::LoggedMechanism2d &value);
 
-private:
-	static constexpr int RECEIVER_QUEUE_CAPACITY = 500;
-
-	static bool running;
-	static long cycleCount;
-	static LogTable entry;
-	static std::mutex entryMutex;
-	static std::optional<LogTable> outputTable;
-	static std::unordered_map<std::string, std::string> metadata;
-	static std::unique_ptr<ConsoleSource> console;
-	static std::vector<nt::LoggedNetworkInput*> dashboardInputs;
-	// urclSupplier
-	static bool enableConsole;
-	static bool checkRobotBase;
+	// Registers an output for RecordOutput(handle, value). A replay source
+	// must be set before registering, so the handle uses the right table.
+	template<typename T>
+	static LogTable::Handle<T> RegisterOutput(std::string key) {
+		return GetContext().RegisterOutput<T>(std::move(key));
+	}
+	// Logs a getter every cycle after user code, like @AutoLogOutput in
+	// Java. Accepts the same arguments as AutoLogOutputManager::Register,
+	// e.g. AutoLogOutput("Drive/Pose", *this, &Drive::GetPose). Call from the
+	// robot loop thread, after setting any replay source.
+	template<typename ... Args>
+	static AutoLogOutputManager::EntryId AutoLogOutput(std::string key,
+			Args &&... args) {
+		return GetContext().AutoLogOutput(std::move(key),
+				std::forward<Args>(args)...);
+	}
+	static void RemoveAutoLogOutput(AutoLogOutputManager::EntryId id) {
+		GetContext().RemoveAutoLogOutput(id);
+	}
 
-	static std::unique_ptr<LogReplaySource> replaySource;
-	static moodycamel::BlockingConcurrentQueue<LogTable> receiverQueue;
-	static std::unique_ptr<ReceiverThread> receiverThread;
-	static bool receiverQueueFault;
+	template<typename T>
+	inline static void RecordOutput(LogTable::Handle<T> &handle,
+			const T &value) {
+		GetContext().RecordOutput(handle, value);
+	}
 };
 
 }
@@ -0,0 +1,249 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include "akit/LogTable.h"
+#include "akit/AutoLogOutputManager.h"
+#include "akit/ConsoleSource.h"
+#include "akit/networktables/LoggedNetworkInput.h"
+#include "akit/LogReplaySource.h"
+#include "akit/PeriodicScheduler.h"
+#include "akit/SampleStager.h"
+#include "akit/ReceiverThread.h"
+#include "akit/mechanism/LoggedMechanism2d.h"
+
+namespace akit {
+
+// The state of one logging or replay session. Logger's static API is a
+// facade over the context bound to the calling thread, or the default
+// context if none is, so several replays can run on separate threads of
+// one process, each driving its own context:
+//
+//   LoggerContext context;
+//   LoggerContext::Scope scope { context };
+//   context.SetReplaySource(std::make_unique < wpilog::WPILOGReader > (path));
+//   context.Start();
+//   while (context.IsRunning()) {
+//       context.PeriodicBeforeUser();
+//       robot.Periodic();
+//       context.PeriodicAfterUser(0_ms, 0_ms);
+//   }
+//
+// Console capture, Conduit (HAL) capture, the simulated DriverStation and
+// profiling are process-wide, so only the default context uses them.
+class LoggerContext {
+public:
+	// Binds a context to the calling thread until the scope ends, so the
+	// static Logger API and robot code on that thread use it
+	class Scope {
+	public:
+		explicit Scope(LoggerContext &context) : previous { current } {
+			current = &context;
+		}
+
+		~Scope() {
+			current = previous;
+		}
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		LoggerContext *previous;
+	};
+
+	LoggerContext();
+	~LoggerContext();
+
+	LoggerContext(const LoggerContext&) = delete;
+	LoggerContext& operator=(const LoggerContext&) = delete;
+
+	static LoggerContext& GetDefault();
+
+	static inline LoggerContext& GetCurrent() {
+		return current ? *current : GetDefault();
+	}
+
+	void SetReplaySource(std::unique_ptr<LogReplaySource> replaySource);
+	void AddDataReceiver(std::unique_ptr<LogDataReceiver> dataReceiver);
+	void RegisterDashboardInput(nt::LoggedNetworkInput&);
+	void RecordMetadata(std::string key, std::string value);
+	void SetReceiverQueuePolicy(ReceiverQueue::Policy policy,
+			units::millisecond_t deadline = 0_ms);
+	void SetLowPriorityPrefixes(std::vector<std::string> prefixes);
+	void DisableConsoleCapture() {
+		enableConsole = false;
+	}
+	void DisableRobotBaseCheck() {
+		checkRobotBase = false;
+	}
+	void SetConsoleSource(std::unique_ptr<ConsoleSource> console) {
+		this->console = std::move(console);
+	}
+	bool HasReplaySource() const {
+		return static_cast<bool>(replaySource);
+	}
+	// False before Start and once End is called, including when a replay
+	// source runs out of cycles
+	bool IsRunning() const {
+		return running;
+	}
+	// How long End waits for the receivers to write the queued cycles
+	// before dropping the rest and leaving receivers that are still busy to
+	// end in the background. Replay always waits for every cycle.
+	void SetShutdownDeadline(units::millisecond_t deadline) {
+		shutdownDeadline = deadline;
+	}
+	void Start();
+	// Stops accepting cycles, drains the receivers' queues, and ends the
+	// receivers
+	ReceiverThread::DrainResult End();
+	void PeriodicBeforeUser();
+	void PeriodicAfterUser(units::millisecond_t userCodeLength,
+			units::millisecond_t periodicBeforeLength,
+			std::string extraConsoleData = "");
+
+	bool GetReceiverQueueFault() const {
+		return receiverQueueFault;
+	}
+	units::second_t GetTimestamp() const;
+	void RunEveryN(size_t n, std::function<void()> function);
+	PeriodicScheduler::TaskId SchedulePeriodic(std::string name, size_t period,
+			std::function<void()> function) {
+		return scheduler.Add(std::move(name), period, std::move(function));
+	}
+	void ProcessInputs(std::string key, inputs::LoggableInputs &inputs);
+
+	template<typename T>
+	void RecordOutput(std::string key, T value) {
+		if (!running || IsShed(key))
+			return;
+		if (IsLoggingThread())
+			outputTable->Put(key, value);
+		else if constexpr (requires { stager.Stage(0_s, key, value); })
+			// Resolved on the logging thread when merged
+			stager.Stage(GetSampleTimestamp(),
+					std::string { GetOutputTableName() } + "/" + key, value);
+		else
+			Stage([&](LogTable &staging) {
+				staging.GetSubtable(GetOutputTableName()).Put(key, value);
+			});
+	}
+
+	template<typename T>
+	LogTable::Handle<T> RegisterOutput(std::string key) {
+		return entry.GetSubtable(GetOutputTableName()).Register<T>(
+				std::move(key));
+	}
+
+	template<typename T>
+	void RecordOutput(LogTable::Handle<T> &handle, const T &value) {
+		if (!running || IsShed(handle.GetKey()))
+			return;
+		if (IsLoggingThread())
+			handle.Set(value);
+		else
+			stager.Stage(GetSampleTimestamp(), handle.GetId(), value);
+	}
+
+	template<typename ... Args>
+	AutoLogOutputManager::EntryId AutoLogOutput(std::string key,
+			Args &&... args) {
+		return GetAutoLogOutputs().Register(std::move(key),
+				std::forward<Args>(args)...);
+	}
+	void RemoveAutoLogOutput(AutoLogOutputManager::EntryId id) {
+		GetAutoLogOutputs().Unregister(id);
+	}
+
+private:
+	static constexpr int RECEIVER_QUEUE_CAPACITY = 500;
+
+	inline bool IsDefault() const {
+		return this == &GetDefault();
+	}
+
+	bool IsLoggingThread() const {
+		return std::this_thread::get_id() == loggingThread;
+	}
+
+	// Safe to call from any thread, unlike reading replaySource
+	const char* GetOutputTableName() const {
+		return replaying.load(std::memory_order_relaxed) ?
+				"ReplayOutputs" : "RealOutputs";
+	}
+
+	// Time of a write made off the logging thread
+	units::second_t GetSampleTimestamp() const;
+
+	template<typename F>
+	void Stage(F &&write) {
+		LogTable staging { GetSampleTimestamp() };
+		write(staging);
+		stager.Stage(staging);
+	}
+
+	LogTable GetReplayedTable();
+
+	AutoLogOutputManager& GetAutoLogOutputs() {
+		if (!autoLogOutputs)
+			autoLogOutputs.emplace(entry.GetSubtable(GetOutputTableName()));
+		return *autoLogOutputs;
+	}
+
+	bool IsShed(std::string_view key) const {
+		if (!receiverQueueDegraded.load(std::memory_order_relaxed))
+			return false;
+		for (auto &prefix : lowPriorityPrefixes) {
+			if (key.starts_with(prefix))
+				return true;
+		}
+		return false;
+	}
+
+	static thread_local LoggerContext *current;
+	// Contexts between Start and End, so the time source is only restored
+	// when the last one ends
+	static std::atomic<int> runningContexts;
+
+	std::atomic<bool> running = false;
+	long cycleCount = 0;
+	LogTable entry { 0_s };
+	std::optional<LogTable> outputTable;
+	std::unordered_map<std::string, std::string> metadata;
+	std::unique_ptr<ConsoleSource> console;
+	std::vector<nt::LoggedNetworkInput*> dashboardInputs;
+	// urclSupplier
+	bool enableConsole = true;
+	bool checkRobotBase = true;
+
+	std::unique_ptr<LogReplaySource> replaySource;
+	// Whether replaySource is set, for threads other than the logging thread
+	std::atomic<bool> replaying = false;
+	// Kept across sessions, so Start after End logs to the same receivers
+	std::vector<std::shared_ptr<LogDataReceiver>> dataReceivers;
+	ReceiverQueue::Policy receiverPolicy = ReceiverQueue::Policy::DROP_NEWEST;
+	units::millisecond_t receiverDeadline = 0_ms;
+	std::unique_ptr<ReceiverThread> receiverThread;
+	units::millisecond_t shutdownDeadline = 2000_ms;
+	bool receiverQueueFault = false;
+	std::atomic<bool> receiverQueueDegraded = false;
+	std::vector<std::string> lowPriorityPrefixes;
+	PeriodicScheduler scheduler;
+	std::optional<AutoLogOutputManager> autoLogOutputs;
+	std::thread::id loggingThread;
+	SampleStager stager;
+	// Published each replayed cycle for threads other than the logging
+	// thread
+	std::shared_ptr<const LogTable> replayedTable;
+	std::mutex replayedTableMutex;
+};
+
+}
@@ -0,0 +1,88 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+#include "akit/Profiler.h"
+
+namespace akit {
+
+// Runs tasks every N cycles, each in its own phase so that tasks with common
+// periods do not all land on the same cycle. Phases are chosen to minimise
+// the predicted peak cost of any cycle, using each task's measured cost, and
+// are rebalanced periodically as costs change. Task durations are also
+// recorded as profiler spans under "Scheduler/<name>".
+class PeriodicScheduler {
+public:
+	using TaskId = size_t;
+
+	struct TaskStats {
+		std::string name;
+		size_t period;
+		size_t phase;
+		// Exponential moving average of the run time
+		units::millisecond_t cost;
+		units::millisecond_t maxCost;
+	};
+
+	// Registers a task to run once every period cycles, starting within the
+	// next period cycles
+	TaskId Add(std::string name, size_t period, std::function<void()> task);
+
+	// Runs the tasks due this cycle. Call once per cycle.
+	void Run();
+
+	// Reassigns every phase by measured cost. Run calls this every
+	// REBALANCE_CYCLES cycles; a task whose phase moves runs once at a shorter
+	// or longer interval.
+	void Rebalance();
+
+	// Predicted cost of the most expensive cycle, as of the last rebalance
+	units::millisecond_t GetPredictedPeak() const {
+		return predictedPeak;
+	}
+
+	std::vector<TaskStats> GetStats() const;
+
+private:
+	static constexpr size_t REBALANCE_CYCLES = 500;
+	static constexpr size_t MAX_HORIZON = 3000;
+	static constexpr double COST_SMOOTHING = 0.1;
+
+	struct Task {
+		std::string name;
+		size_t period;
+		size_t phase = SIZE_MAX;
+		std::function<void()> function;
+		Profiler::SpanId span;
+		double costMS = 0;
+		double maxCostMS = 0;
+		size_t runs = 0;
+	};
+
+	// Load of each cycle in one horizon
+	struct Load {
+		std::vector<double> cost;
+		std::vector<size_t> count;
+	};
+
+	size_t GetHorizon() const;
+	Load MakeLoad(size_t horizon) const;
+	void AssignPhase(Task &task, Load &load);
+	void UpdatePeak(const Load &load);
+
+	// Tasks may add tasks while running
+	std::deque<Task> tasks;
+	size_t cycle = 0;
+	units::millisecond_t predictedPeak = 0_ms;
+};
+
+}
@@ -0,0 +1,69 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#pragma once
+#include <memory>
+#include <optional>
+#include <thread>
+#include "akit/LogReplaySource.h"
+#include "akit/ReceiverQueue.h"
+
+namespace akit {
+
+// Decodes replay cycles ahead of the robot code. A decode thread runs the
+// wrapped source into its own table and queues a snapshot of each cycle, so
+// decoding the next cycles overlaps with user code and the receivers. Cycles
+// are applied in order and none are skipped, so the replayed table matches
+// what the wrapped source would have produced.
+//
+//   Logger::SetReplaySource(std::make_unique < PipelinedReplaySource > (
+//           std::make_unique < wpilog::WPILOGReader > (path)));
+class PipelinedReplaySource: public LogReplaySource {
+public:
+	explicit PipelinedReplaySource(std::unique_ptr<LogReplaySource> source,
+			size_t depth = 32);
+
+	~PipelinedReplaySource();
+
+	void Start() override;
+
+	// Waits for the next decoded cycle. Returns false once the wrapped
+	// source has no more cycles.
+	bool UpdateTable(LogTable &table) override;
+
+	// Stops decoding, seeks the wrapped source and decodes ahead from the
+	// new position. The next update removes replayed fields the new
+	// position does not have. If the wrapped source cannot seek, replay
+	// continues where it was.
+	bool Seek(units::second_t timestamp) override;
+
+	// Decoded cycles waiting to be applied
+	inline size_t GetQueuedCycles() const {
+		return queue.GetStats().size;
+	}
+
+private:
+	void Decode();
+
+	void StartDecoding();
+
+	void StopDecoding();
+
+	std::unique_ptr<LogReplaySource> source;
+	ReceiverQueue queue;
+	std::thread decodeThread;
+	// Only used by the decode thread while it runs
+	LogTable decoded { 0_s };
+	// Decoded cycle the queue was closed on before it could be queued
+	std::optional<LogTable> unqueued;
+	// Last cycle applied, so only the next cycle's changes are written
+	std::optional<LogTable> applied;
+	// Set by a seek, so the next cycle replaces the fields it does not have
+	bool replaceNext = false;
+};
+
+}
@@ -0,0 +1,127 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <units/time.h>
+#include "akit/LogTable.h"
+
+#define AKIT_PROFILE_CONCAT_INNER(a, b) a##b
+#define AKIT_PROFILE_CONCAT(a, b) AKIT_PROFILE_CONCAT_INNER(a, b)
+
+// Declares a span named variable that times the rest of the enclosing scope,
+// or until variable.End(). The name is registered once per call site.
+#define AKIT_PROFILE_SPAN(variable, name) \
+	static const ::akit::Profiler::SpanId AKIT_PROFILE_CONCAT(variable, Id) = \
+			::akit::Profiler::RegisterSpan(name); \
+	::akit::Profiler::Span variable { AKIT_PROFILE_CONCAT(variable, Id) }
+
+// Times the rest of the enclosing scope, e.g. AKIT_PROFILE("Drive/Odometry")
+#define AKIT_PROFILE(name) \
+	AKIT_PROFILE_SPAN(AKIT_PROFILE_CONCAT(akitProfileSpan, __LINE__), name)
+
+namespace akit {
+
+// Records scoped spans into a per-thread ring buffer. Once per cycle, Logger
+// flushes the logging thread's spans under "Profiling/" in the output table
+// (RealOutputs, or ReplayOutputs in replay): the total duration of each span
+// in the cycle as "<name>MS", and its p50, p99 and max over the last
+// WINDOW_CYCLES cycles it ran in as "<name>/P50MS", "<name>/P99MS" and
+// "<name>/MaxMS". Spans closed on other threads are not logged. Spans are
+// recorded flat, by name; nesting is not tracked, so give nested spans
+// nested names such as "Drive/Odometry" inside "Drive".
+class Profiler {
+public:
+	using SpanId = uint16_t;
+	using Clock = std::chrono::steady_clock;
+
+	static constexpr size_t RING_CAPACITY = 1024;
+	static constexpr size_t WINDOW_CYCLES = 250;
+
+	class Span {
+	public:
+		explicit Span(SpanId id) : id { id }, start { Clock::now() } {
+		}
+
+		~Span() {
+			if (!ended)
+				End();
+		}
+
+		Span(const Span&) = delete;
+		Span& operator=(const Span&) = delete;
+
+		// Closes the span before the end of its scope and returns its
+		// duration. Later calls return the same duration without recording
+		// the span again.
+		inline units::millisecond_t End() {
+			if (!ended) {
+				duration = Clock::now() - start;
+				ended = true;
+				Ring &buffer = ring;
+				buffer.records[buffer.next++ % RING_CAPACITY] = { id, duration };
+			}
+			return units::millisecond_t {
+					std::chrono::duration<double, std::milli> { duration }.count() };
+		}
+
+	private:
+		SpanId id;
+		Clock::time_point start;
+		Clock::duration duration { };
+		bool ended = false;
+	};
+
+	// Returns the ID for a span name, registering it the first time
+	static SpanId RegisterSpan(std::string_view name);
+
+	// Logs the spans closed on this thread since the previous flush
+	static void Flush(LogTable &&table);
+
+private:
+	struct Record {
+		SpanId id;
+		Clock::duration duration;
+	};
+
+	struct Ring {
+		std::array<Record, RING_CAPACITY> records;
+		uint64_t next = 0;
+		uint64_t flushed = 0;
+	};
+
+	struct SpanInfo {
+		std::string durationKey;
+		std::string p50Key;
+		std::string p99Key;
+		std::string maxKey;
+		std::vector<double> window;
+		std::vector<double> sorted;
+		size_t windowNext = 0;
+		double cycleTotal = 0;
+		bool ranThisCycle = false;
+	};
+
+	static thread_local Ring ring;
+
+	static std::mutex mutex;
+	static std::unordered_map<std::string, SpanId> ids;
+	static std::deque<SpanInfo> spans;
+	static uint64_t droppedSpans;
+};
+
+inline thread_local Profiler::Ring Profiler::ring;
+
+}
@@ -0,0 +1,95 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <units/time.h>
+#include "akit/LogTable.h"
+
+namespace akit {
+
+// Bounded queue of cycle snapshots waiting for the receivers. The policy
+// decides what happens to a cycle that arrives while the queue is full.
+//
+// Receivers write the fields changed since the revision of the last table
+// they saw, so dropping or merging queued cycles never loses the latest value
+// of a field, only the intermediate values and timestamps.
+class ReceiverQueue {
+public:
+	enum class Policy {
+		// Discard the new cycle
+		DROP_NEWEST,
+		// Wait up to the deadline for space, then discard the new cycle
+		BLOCK_WITH_DEADLINE,
+		// Wait for space without a deadline, so no cycle is discarded. Used
+		// in replay, where every cycle must reach the receivers.
+		BLOCK,
+		// Discard the oldest queued cycle to make space
+		DROP_OLDEST,
+		// Replace the newest queued cycle, merging both into one delta
+		COALESCE,
+		// Coalesce, and report the queue as degraded from three quarters full
+		// until it drains to a quarter, so low-priority writes can be skipped
+		DEGRADE
+	};
+
+	struct Stats {
+		size_t size = 0;
+		size_t highWater = 0;
+		size_t droppedCycles = 0;
+		size_t coalescedCycles = 0;
+		units::millisecond_t lastBlockedTime = 0_ms;
+		bool degraded = false;
+	};
+
+	explicit ReceiverQueue(size_t capacity) : capacity { capacity } {
+	}
+
+	void SetPolicy(Policy policy, units::millisecond_t deadline = 0_ms);
+
+	// Returns false if a cycle was discarded to apply the policy
+	bool Enqueue(LogTable table);
+
+	// Blocks until a cycle is available. Returns nothing once the queue is
+	// closed and empty.
+	std::optional<LogTable> Dequeue();
+
+	// Wakes blocked readers and writers. Cycles already queued can still be
+	// dequeued, and new cycles are dropped.
+	void Close();
+
+	// Accepts cycles again after Close
+	void Reopen();
+
+	// Drops every queued cycle, counting them as dropped. Returns how many
+	// were dropped.
+	size_t Discard();
+
+	Stats GetStats() const;
+
+	bool IsDegraded() const {
+		std::lock_guard lock { mutex };
+		return stats.degraded;
+	}
+
+private:
+	const size_t capacity;
+	Policy policy = Policy::DROP_NEWEST;
+	units::millisecond_t deadline = 0_ms;
+
+	mutable std::mutex mutex;
+	std::condition_variable notEmpty;
+	std::condition_variable notFull;
+	std::deque<LogTable> queue;
+	Stats stats;
+	bool closed = false;
+};
+
+}
@@ -5,25 +5,89 @@
 // license that can be found in the LICENSE file
 // at the root directory of this project.
 
-#include <queue>
+#pragma once
+#include <atomic>
+#include <functional>
+#include <future>
+#include <optional>
 #include <thread>
-#include <blockingconcurrentqueue.h>
-#include "akit/LogTable.h"
+#include "akit/ReceiverQueue.h"
 #include "akit/LogDataReceiver.h"
 
 namespace akit {
 
+// Fans each cycle out to the data receivers. Every receiver has its own
+// bounded queue and worker thread, so a slow receiver only falls behind (and
+// drops cycles by its queue's policy) without delaying the others.
 class ReceiverThread {
 public:
-	void AddDataReceiver(std::unique_ptr<LogDataReceiver> receiver);
-	ReceiverThread(moodycamel::BlockingConcurrentQueue<LogTable> &queue);
+	struct ReceiverStats {
+		ReceiverQueue::Stats queue;
+		// Log time between the newest queued cycle and the last one the
+		// receiver finished
+		units::millisecond_t lag = 0_ms;
+	};
+
+	// Cycles queued when Stop was called, summed over the receivers
+	struct DrainResult {
+		size_t flushedCycles = 0;
+		size_t droppedCycles = 0;
+	};
+
+	explicit ReceiverThread(size_t queueCapacity) : queueCapacity {
+			queueCapacity } {
+	}
+	~ReceiverThread();
+
+	void AddDataReceiver(std::shared_ptr<LogDataReceiver> receiver);
+
+	// Applies to receivers added before and after the call
+	void SetPolicy(ReceiverQueue::Policy policy,
+			units::millisecond_t deadline = 0_ms);
+
+	// Starts a worker for each receiver. Each worker calls threadInit first,
+	// before starting its receiver.
+	void Start(std::function<void()> threadInit = { });
+
+	// Queues the cycle for every receiver. Returns false if any receiver's
+	// queue discarded a cycle.
+	bool PutTable(const LogTable &table);
+
+	// In the order receivers were added
+	std::vector<ReceiverStats> GetStats() const;
+
+	bool IsDegraded() const;
+
+	// Stops accepting cycles and lets each receiver finish its queue, then
+	// calls its End. Cycles still queued after the deadline are dropped, and
+	// a worker still writing a cycle or in End is detached, so Stop returns
+	// at the deadline; the worker ends its receiver once the call returns.
+	// Without a deadline, every queued cycle is written.
+	DrainResult Stop(std::optional<units::millisecond_t> deadline =
+			std::nullopt);
 
 private:
-	void Run();
+	struct Worker {
+		Worker(std::shared_ptr<LogDataReceiver> receiver, size_t capacity) : receiver {
+				std::move(receiver) }, queue { capacity } {
+		}
+
+		void Run();
+
+		std::shared_ptr<LogDataReceiver> receiver;
+		ReceiverQueue queue;
+		std::atomic<double> finishedTimestamp = 0;
+		std::promise<void> finished;
+		std::thread thread;
+	};
 
-	std::thread thread { &ReceiverThread::Run, this };
-	moodycamel::BlockingConcurrentQueue<LogTable> &queue;
-	std::vector<std::unique_ptr<LogDataReceiver>> dataReceivers;
+	const size_t queueCapacity;
+	ReceiverQueue::Policy policy = ReceiverQueue::Policy::DROP_NEWEST;
+	units::millisecond_t deadline = 0_ms;
+	units::second_t latestTimestamp = 0_s;
+	// Shared with the worker's thread, so a detached worker outlives this
+	std::vector<std::shared_ptr<Worker>> workers;
+	bool stopped = false;
 };
 
 }
@@ -0,0 +1,81 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#pragma once
+#include <optional>
+#include <string>
+#include <vector>
+#include <concurrentqueue.h>
+#include "akit/LogTable.h"
+
+namespace akit {
+
+// Collects writes made on threads other than the logging thread. Each
+// writing thread enqueues into its own lock-free sub-queue, and the logging
+// thread merges everything into the cycle's table once per cycle, keeping
+// the order of each thread's writes. Keys are resolved on the logging
+// thread, so staging never takes the registries' locks.
+class SampleStager {
+public:
+	// Queues every field in table as a sample at the table's timestamp. Safe
+	// to call from any thread.
+	void Stage(const LogTable &table);
+
+	// Queues value as a sample of a field already resolved, e.g. through a
+	// handle. Safe to call from any thread.
+	template<typename T>
+	void Stage(units::second_t timestamp, KeyRegistry::FieldId id,
+			const T &value) {
+		queue.enqueue(Write { LogTable::Sample { timestamp, id,
+				LogTable::MakeValue(value) } });
+	}
+
+	// Queues value as a sample of the field at key, relative to the root of
+	// the table it is merged into. Safe to call from any thread.
+	template<typename T>
+	requires (LogTable::IsFieldValue<T>())
+	void Stage(units::second_t timestamp, std::string key, const T &value) {
+		Write write { LogTable::Sample { timestamp, 0, LogTable::MakeValue(
+				value) }, std::move(key) };
+		if constexpr (IsStruct<T>())
+			write.addSchema = [](LogTable &table) {
+				table.AddStructSchema<T>();
+			};
+		else if constexpr (requires { typename T::value_type; }) {
+			if constexpr (IsStruct<typename T::value_type>())
+				write.addSchema = [](LogTable &table) {
+					table.AddStructSchema<typename T::value_type>();
+				};
+		}
+		queue.enqueue(std::move(write));
+	}
+
+	// Adds the queued samples to table. Call from the logging thread only.
+	// Returns the number of samples merged.
+	size_t MergeInto(LogTable &table);
+
+private:
+	static constexpr size_t MERGE_BATCH = 64;
+
+	template<typename T>
+	static constexpr bool IsStruct() {
+		return wpi::StructSerializable<T> && !std::is_arithmetic_v<T>;
+	}
+
+	struct Write {
+		LogTable::Sample sample;
+		// Resolved when merged if not empty, replacing the sample's ID
+		std::string key;
+		void (*addSchema)(LogTable&) = nullptr;
+	};
+
+	moodycamel::ConcurrentQueue<Write> queue;
+	std::vector<std::optional<Write>> batch = std::vector<std::optional<Write>>(
+			MERGE_BATCH);
+};
+
+}
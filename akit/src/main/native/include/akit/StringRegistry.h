@@ -0,0 +1,46 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace akit {
+
+// Interns the custom type and unit strings attached to log values (e.g.
+// "struct:Pose2d" or "meter"). There are only a handful of distinct strings,
+// so values store a small ID and compare IDs instead of strings. ID 0 is
+// always the empty string.
+class StringRegistry {
+public:
+	using StringId = uint16_t;
+
+	static constexpr StringId EMPTY = 0;
+
+	static StringId GetId(std::string_view string);
+
+	static const std::string& GetString(StringId id);
+
+private:
+	struct StringHash {
+		using is_transparent = void;
+		size_t operator()(std::string_view string) const {
+			return std::hash<std::string_view> { }(string);
+		}
+	};
+
+	static std::shared_mutex mutex;
+	static std::unordered_map<std::string, StringId, StringHash,
+			std::equal_to<>> ids;
+	static std::deque<std::string> strings;
+};
+
+}
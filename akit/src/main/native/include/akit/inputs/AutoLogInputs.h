@@ -0,0 +1,78 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include "akit/LogTable.h"
+
+// Generates ToLog and FromLog for a LoggableInputs subclass from a single
+// list of its fields, the C++ counterpart of the Java @AutoLog annotation.
+// Keys are derived from the field names the same way, so "leftVelocity" and
+// "m_leftVelocity" are both logged as "LeftVelocity". Place it at the end of
+// the class body; it leaves the class in public access.
+//
+//   class DriveIOInputs: public akit::inputs::LoggableInputs {
+//   public:
+//       units::meter_t leftPosition = 0_m;
+//       double leftAppliedVolts = 0;
+//
+//       AKIT_AUTOLOG_INPUTS(leftPosition, leftAppliedVolts)
+//   };
+#define AKIT_AUTOLOG_INPUTS(...) \
+	private: \
+	::akit::inputs::AutoLogFields autoLogFields; \
+	public: \
+	void ToLog(::akit::LogTable &&table) override { \
+		autoLogFields.ToLog(table, #__VA_ARGS__, __VA_ARGS__); \
+	} \
+	void FromLog(::akit::LogTable &&table) override { \
+		autoLogFields.FromLog(table, #__VA_ARGS__, __VA_ARGS__); \
+	}
+
+namespace akit::inputs {
+
+// Field IDs of an AKIT_AUTOLOG_INPUTS class. They are resolved from the
+// field list the first time the inputs are logged under a prefix, so each
+// later cycle writes and reads its fields by ID without building any keys.
+class AutoLogFields {
+public:
+	template<typename ... T>
+	void ToLog(LogTable &table, std::string_view fieldList,
+			const T &... fields) {
+		Resolve(table, fieldList);
+		size_t i = 0;
+		(table.PutField(ids[i++], fields), ...);
+	}
+
+	template<typename ... T>
+	void FromLog(LogTable &table, std::string_view fieldList, T &... fields) {
+		Resolve(table, fieldList);
+		size_t i = 0;
+		((fields = table.GetField(ids[i++], std::move(fields))), ...);
+	}
+
+	// Returns the key a field is logged under, e.g. "LeftVelocity" for
+	// "m_leftVelocity"
+	static std::string GetKey(std::string_view field);
+
+private:
+	inline void Resolve(const LogTable &table, std::string_view fieldList) {
+		if (resolved && table.GetPrefix() == prefix)
+			return;
+		ResolveIds(table, fieldList);
+	}
+
+	void ResolveIds(const LogTable &table, std::string_view fieldList);
+
+	bool resolved = false;
+	std::string prefix;
+	std::vector<KeyRegistry::FieldId> ids;
+};
+
+}
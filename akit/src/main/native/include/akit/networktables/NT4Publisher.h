@@ -23,10 +23,12 @@ public:
 
 private:
 	std::shared_ptr<::nt::NetworkTable> akitTable;
-	LogTable lastTable { 0_s };
+	// Revision of the last table published, see LogTable::ForEachChange
+	uint64_t lastRevision = 0;
 	::nt::IntegerPublisher timestampPublisher;
-	std::unordered_map<std::string, ::nt::GenericPublisher> publishers;
-	std::unordered_map<std::string, std::string> units;
+	// Indexed by KeyRegistry::FieldId
+	std::vector<std::optional<::nt::GenericPublisher>> publishers;
+	std::vector<StringRegistry::StringId> units;
 };
 
 }
@@ -13,25 +13,99 @@ namespace akit {
 
 namespace wpilog {
 
-class WPILOGReader: LogReplaySource {
+class WPILOGReader: public LogReplaySource {
 public:
-	WPILOGReader(std::string filename) : filename { filename } {
+	// Replays only part of the log, as "start:end" in seconds of log time.
+	// Either side may be empty, and negative times count back from the end
+	// of the log, so "-30:" replays the last 30 seconds.
+	static constexpr const char *WINDOW_ENV = "AKIT_REPLAY_WINDOW";
+
+	// With persistIndex, the timestamp index is saved next to the log the
+	// first time it is built and loaded from there on later seeks
+	WPILOGReader(std::string filename, bool persistIndex = true) : filename {
+			filename }, persistIndex { persistIndex } {
 	}
 
 	void Start() override;
-	bool UpdateTable(LogTable &table);
+	bool UpdateTable(LogTable &table) override;
+
+	// Finds the cycle in O(log n) through the timestamp index, rebuilds the
+	// table from the nearest keyframe before it and decodes forward from
+	// there. The index is built or loaded on the first seek.
+	bool Seek(units::second_t timestamp) override;
+
+	// Ends replay before the first cycle after timestamp
+	inline void SetEndTimestamp(units::second_t timestamp) {
+		endTimestamp = timestamp;
+	}
+
+	inline std::string GetIndexPath() const {
+		return filename + ".akitindex";
+	}
 
 private:
+	struct Entry {
+		std::string key;
+		LogTable::LoggableType type;
+		std::string customType;
+		bool isTimestamp;
+		bool isReplayOutput;
+	};
+
+	// Offset of the first record of a cycle, just after its timestamp
+	struct Cycle {
+		int64_t timestamp;
+		size_t offset;
+	};
+
+	// Offsets of the latest record of every field before a cycle, so the
+	// table at that cycle is rebuilt by decoding one record per field
+	struct Keyframe {
+		size_t cycle;
+		std::vector<size_t> records;
+	};
+
+	// "WPILOG", the version and the extra header length
+	static constexpr size_t HEADER_SIZE = 12;
+	static constexpr size_t KEYFRAME_INTERVAL = 500;
+
+	void ReadStart(const wpi::log::DataLogRecord &record);
+
+	// Decodes one cycle, stopping after the timestamp of the next cycle.
+	// Returns false at the end of the log.
+	bool ReadCycle(LogTable &table);
+
+	void ReadValue(const wpi::log::DataLogRecord &record, const Entry &entry,
+			LogTable &table);
+
+	void ApplyWindow(std::string_view window);
+
+	size_t OffsetAfter(const wpi::log::DataLogRecord &record) const;
+
+	// Builds or loads the index if needed. Returns false if the log has no
+	// cycles.
+	bool EnsureIndex();
+	void BuildIndex();
+	bool LoadIndex();
+	void SaveIndex() const;
+
 	std::string filename;
-	bool isValid;
+	bool persistIndex;
+	bool isValid = false;
 
 	std::optional<wpi::log::DataLogReader> reader;
 	std::optional<wpi::log::DataLogIterator> iterator;
 
-	std::optional<units::second_t> timestamp;
-	std::unordered_map<int, std::string> entryIDs;
-	std::unordered_map<int, LogTable::LoggableType> entryTypes;
-	std::unordered_map<int, std::string> entryCustomTypes;
+	// Log time of the cycle being read, in microseconds
+	std::optional<int64_t> timestamp;
+	std::optional<units::second_t> endTimestamp;
+	std::unordered_map<int, Entry> entries;
+
+	bool indexed = false;
+	std::vector<Cycle> cycles;
+	std::vector<Keyframe> keyframes;
+	// Table state up to the cycle found by Seek, written on the next update
+	std::optional<LogTable> pending;
 };
 
 }
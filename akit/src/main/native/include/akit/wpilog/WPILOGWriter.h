@@ -52,6 +52,11 @@ private:
 	static constexpr std::string_view ADVANTAGESCOPE_FILE_NAME =
 			"ascope-log-path.txt";
 
+	static std::string UnitMetadata(const std::string &unit);
+
+	void Append(KeyRegistry::FieldId id, const LogTable::LogValue &value,
+			int64_t timestamp);
+
 	std::string folder;
 	std::string filename;
 	std::string randomIdentifier;
@@ -64,11 +69,15 @@ private:
 	std::unique_ptr<wpi::log::DataLogWriter> log;
 	bool isOpen = false;
 	AdvantageScopeOpenBehavior openBehavior;
-	std::optional<LogTable> lastTable;
+	uint64_t lastRevision = 0;
 	int timestampID;
-	std::unordered_map<std::string, int> entryIDs;
-	std::unordered_map<std::string, LogTable::LoggableType> entryTypes;
-	std::unordered_map<std::string, std::string> entryUnits;
+	// Indexed by KeyRegistry::FieldId
+	std::vector<std::optional<int>> entryIDs;
+	std::vector<StringRegistry::StringId> entryUnits;
+	// Value of the field's last sample in the table being written, and the
+	// fields that have one
+	std::vector<const LogTable::LogValue*> lastSamples;
+	std::vector<KeyRegistry::FieldId> sampledIds;
 };
 
 }
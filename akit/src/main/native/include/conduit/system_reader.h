@@ -23,5 +23,13 @@ public:
 	void read(schema::SystemData *system_buf);
 
 private:
+	// The slower reads run every PERIOD cycles, offset by PHASE. The phases
+	// differ modulo 10, the periods' common factor, so the two never share
+	// a cycle, and neither shares the first cycle's one-time reads.
+	static constexpr uint64_t SYSTEM_TIME_PERIOD = 50;
+	static constexpr uint64_t SYSTEM_TIME_PHASE = 5;
+	static constexpr uint64_t CAN_STATUS_PERIOD = 20;
+	static constexpr uint64_t CAN_STATUS_PHASE = 10;
+
 	uint64_t cycleCount = 0;
 };
@@ -0,0 +1,38 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Replaces the global allocator for the test binary so tests can check
+// that a path does not allocate
+
+namespace {
+
+std::atomic<size_t> allocationCount;
+
+}
+
+size_t GetAllocationCount() {
+	return allocationCount;
+}
+
+void* operator new(size_t size) {
+	allocationCount++;
+	if (void *pointer = std::malloc(size ? size : 1))
+		return pointer;
+	throw std::bad_alloc { };
+}
+
+void operator delete(void *pointer) noexcept {
+	std::free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept {
+	std::free(pointer);
+}
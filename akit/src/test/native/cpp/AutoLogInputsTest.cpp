@@ -0,0 +1,110 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <gtest/gtest.h>
+#include <frc/geometry/Pose2d.h>
+#include "akit/inputs/AutoLogInputs.h"
+
+using namespace akit;
+
+namespace {
+
+enum class Mode {
+	Idle, Running
+};
+
+class DriveInputs: public inputs::LoggableInputs {
+public:
+	double leftVelocity = 0;
+	units::meter_t m_leftPosition { 0 };
+	bool connected = false;
+	long ticks = 0;
+	Mode mode = Mode::Idle;
+	std::string name;
+	std::vector<double> currents;
+	frc::Pose2d pose;
+
+	AKIT_AUTOLOG_INPUTS(leftVelocity, m_leftPosition, connected, ticks, mode,
+			name, currents, pose)
+};
+
+DriveInputs MakeInputs() {
+	DriveInputs inputs;
+	inputs.leftVelocity = 1.5;
+	inputs.m_leftPosition = units::meter_t { 2 };
+	inputs.connected = true;
+	inputs.ticks = 42;
+	inputs.mode = Mode::Running;
+	inputs.name = "Left";
+	inputs.currents = { 3, 4 };
+	inputs.pose = frc::Pose2d { units::meter_t { 5 }, units::meter_t { 6 },
+			frc::Rotation2d { } };
+	return inputs;
+}
+
+}
+
+TEST(AutoLogInputsTest, KeysMatchJavaAutoLog) {
+	EXPECT_EQ(inputs::AutoLogFields::GetKey("leftVelocity"), "LeftVelocity");
+	EXPECT_EQ(inputs::AutoLogFields::GetKey("m_leftVelocity"), "LeftVelocity");
+	EXPECT_EQ(inputs::AutoLogFields::GetKey("Pose"), "Pose");
+}
+
+TEST(AutoLogInputsTest, WritesSameFieldsAsPut) {
+	LogTable table { 0_s };
+	DriveInputs inputs = MakeInputs();
+	inputs.ToLog(table.GetSubtable("Drive"));
+
+	EXPECT_EQ(table.Get("Drive/LeftVelocity", 0.0), 1.5);
+	EXPECT_EQ(table.Get("Drive/LeftPosition", 0.0), 2.0);
+	EXPECT_EQ(table.Get("Drive/Connected", false), true);
+	EXPECT_EQ(table.Get("Drive/Ticks", 0L), 42);
+	EXPECT_EQ(table.Get("Drive/Mode", std::string { }), "Running");
+	EXPECT_EQ(table.Get("Drive/Name", std::string { }), "Left");
+	EXPECT_EQ(table.Get("Drive/Currents", std::vector<double> { }),
+			(std::vector<double> { 3, 4 }));
+	EXPECT_EQ(table.Get("Drive/Pose", frc::Pose2d { }), inputs.pose);
+}
+
+TEST(AutoLogInputsTest, RoundTrip) {
+	LogTable table { 0_s };
+	DriveInputs inputs = MakeInputs();
+	inputs.ToLog(table.GetSubtable("Drive"));
+
+	DriveInputs replayed;
+	replayed.FromLog(table.GetSubtable("Drive"));
+	EXPECT_EQ(replayed.leftVelocity, 1.5);
+	EXPECT_EQ(replayed.m_leftPosition.value(), 2.0);
+	EXPECT_TRUE(replayed.connected);
+	EXPECT_EQ(replayed.ticks, 42);
+	EXPECT_EQ(replayed.mode, Mode::Running);
+	EXPECT_EQ(replayed.name, "Left");
+	EXPECT_EQ(replayed.currents, (std::vector<double> { 3, 4 }));
+	EXPECT_EQ(replayed.pose, inputs.pose);
+}
+
+TEST(AutoLogInputsTest, MissingFieldsKeepValues) {
+	LogTable table { 0_s };
+	table.Put("Drive/LeftVelocity", "wrong type");
+
+	DriveInputs replayed = MakeInputs();
+	replayed.FromLog(table.GetSubtable("Drive"));
+	EXPECT_EQ(replayed.leftVelocity, 1.5);
+	EXPECT_EQ(replayed.currents, (std::vector<double> { 3, 4 }));
+	EXPECT_EQ(replayed.pose, MakeInputs().pose);
+}
+
+TEST(AutoLogInputsTest, ResolvesAgainForNewPrefix) {
+	LogTable table { 0_s };
+	DriveInputs inputs = MakeInputs();
+	inputs.ToLog(table.GetSubtable("Left"));
+	inputs.leftVelocity = 7;
+	inputs.ToLog(table.GetSubtable("Right"));
+
+	EXPECT_EQ(table.Get("Left/LeftVelocity", 0.0), 1.5);
+	EXPECT_EQ(table.Get("Right/LeftVelocity", 0.0), 7.0);
+}
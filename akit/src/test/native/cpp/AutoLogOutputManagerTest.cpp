@@ -0,0 +1,87 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <gtest/gtest.h>
+#include <frc/geometry/Pose2d.h>
+#include "akit/AutoLogOutputManager.h"
+
+using namespace akit;
+
+namespace {
+
+class Drive {
+public:
+	frc::Pose2d GetPose() const {
+		return pose;
+	}
+
+	const char* GetMode() const {
+		return mode;
+	}
+
+	frc::Pose2d pose;
+	double leftVelocity = 0;
+	const char *mode = "Idle";
+};
+
+}
+
+TEST(AutoLogOutputManagerTest, PollsRegisteredGetters) {
+	LogTable table { 0_s };
+	AutoLogOutputManager manager { table.GetSubtable("RealOutputs") };
+	Drive drive;
+	int calls = 0;
+	manager.Register("Drive/Pose", drive, &Drive::GetPose);
+	manager.Register("Drive/LeftVelocity", drive, &Drive::leftVelocity);
+	manager.Register("Calls", [&] {
+		return ++calls;
+	});
+
+	drive.pose = frc::Pose2d { units::meter_t { 1 }, units::meter_t { 2 },
+			frc::Rotation2d { } };
+	drive.leftVelocity = 3.5;
+	manager.Poll();
+	EXPECT_TRUE(
+			table.Get("RealOutputs/Drive/Pose", frc::Pose2d { })
+					== drive.pose);
+	EXPECT_EQ(table.Get("RealOutputs/Drive/LeftVelocity", 0.0), 3.5);
+	EXPECT_EQ(table.Get("RealOutputs/Calls", 0), 1);
+
+	drive.leftVelocity = 4.0;
+	manager.Poll();
+	EXPECT_EQ(table.Get("RealOutputs/Drive/LeftVelocity", 0.0), 4.0);
+	EXPECT_EQ(table.Get("RealOutputs/Calls", 0), 2);
+}
+
+TEST(AutoLogOutputManagerTest, CStringGetterIsLoggedAsString) {
+	LogTable table { 0_s };
+	AutoLogOutputManager manager { table.GetSubtable("RealOutputs") };
+	Drive drive;
+	manager.Register("Drive/Mode", drive, &Drive::GetMode);
+
+	manager.Poll();
+	EXPECT_EQ(table.Get("RealOutputs/Drive/Mode").type,
+			LogTable::LoggableType::String);
+	EXPECT_EQ(table.Get("RealOutputs/Drive/Mode", std::string { }), "Idle");
+
+	drive.mode = "Tracking";
+	manager.Poll();
+	EXPECT_EQ(table.Get("RealOutputs/Drive/Mode", std::string { }), "Tracking");
+}
+
+TEST(AutoLogOutputManagerTest, UnregisteredGetterIsNotPolled) {
+	LogTable table { 0_s };
+	AutoLogOutputManager manager { table.GetSubtable("RealOutputs") };
+	int calls = 0;
+	auto id = manager.Register("Unregistered", [&] {
+		return ++calls;
+	});
+	manager.Poll();
+	manager.Unregister(id);
+	manager.Poll();
+	EXPECT_EQ(calls, 1);
+}
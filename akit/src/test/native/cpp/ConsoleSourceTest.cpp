@@ -0,0 +1,73 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <chrono>
+#include <cstdio>
+#include <gtest/gtest.h>
+#include "akit/ConsoleSource.h"
+
+using namespace akit;
+
+namespace {
+
+// Output can still be in the pipe when GetNewData is first called
+std::string ReadUntil(ConsoleSource &source, std::string_view expected) {
+	std::string data;
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds { 5 };
+	while (data.find(expected) == std::string::npos
+			&& std::chrono::steady_clock::now() < deadline) {
+		data += source.GetNewData();
+		std::this_thread::sleep_for(std::chrono::milliseconds { 1 });
+	}
+	return data;
+}
+
+}
+
+TEST(ConsoleSourceTest, RingReadsIncrementally) {
+	ConsoleRingBuffer ring { 8 };
+	ring.Write("abc");
+	ring.Write("de");
+	EXPECT_EQ(ring.Read(), "abcde");
+	EXPECT_EQ(ring.Read(), "");
+	// Wraps around the end of the buffer
+	ring.Write("fghij");
+	size_t dropped = 1;
+	EXPECT_EQ(ring.Read(&dropped), "fghij");
+	EXPECT_EQ(dropped, 0u);
+}
+
+TEST(ConsoleSourceTest, RingDropsOldestWhenFull) {
+	ConsoleRingBuffer ring { 8 };
+	ring.Write("abcdef");
+	ring.Write("ghij");
+	size_t dropped = 0;
+	EXPECT_EQ(ring.Read(&dropped), "cdefghij");
+	EXPECT_EQ(dropped, 2u);
+
+	ring.Write("abc");
+	ring.Write("0123456789");
+	EXPECT_EQ(ring.Read(&dropped), "23456789");
+	EXPECT_EQ(dropped, 5u);
+}
+
+TEST(ConsoleSourceTest, CapturesStreamsAndPrintf) {
+	SimulatorConsoleSource source;
+	std::cout << "from cout" << std::endl;
+	std::printf("from printf\n");
+	std::cerr << "from cerr" << std::endl;
+	std::string data = ReadUntil(source, "from cerr");
+	EXPECT_NE(data.find("from cout\n"), std::string::npos);
+	EXPECT_NE(data.find("from cerr\n"), std::string::npos);
+#ifndef _WIN32
+	EXPECT_NE(data.find("from printf\n"), std::string::npos);
+#endif
+
+	std::cout << "next cycle" << std::endl;
+	data = ReadUntil(source, "next cycle");
+	EXPECT_EQ(data, "next cycle\n");
+}
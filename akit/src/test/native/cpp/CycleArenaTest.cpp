@@ -0,0 +1,60 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <gtest/gtest.h>
+#include "akit/CycleArena.h"
+#include "akit/LogTable.h"
+
+using namespace akit;
+
+TEST(CycleArenaTest, ArenaCopyMatchesOriginal) {
+	LogTable table { 1_s };
+	table.Put("Currents", std::vector<double>(24, 1.5));
+	table.Put("Console", std::string(200, 'x'));
+	table.Put("Names", std::vector<std::string> { "Left", "Right" });
+
+	auto arena = CycleArena::Acquire();
+	LogTable copy = table.Snapshot(arena);
+	EXPECT_GT(arena->GetBytesAllocated(), 0u);
+	EXPECT_EQ(copy.GetTimestamp(), 1_s);
+	EXPECT_EQ(copy.Get("Currents", std::vector<double> { }),
+			std::vector<double>(24, 1.5));
+	EXPECT_EQ(copy.Get("Console", std::string { }), std::string(200, 'x'));
+	EXPECT_TRUE(copy.Get("Names") == table.Get("Names"));
+}
+
+TEST(CycleArenaTest, ArenaReturnsToPoolWithLastCopy) {
+	size_t idleBefore;
+	{
+		// The table keeps its last snapshot's chunks to share with the next
+		LogTable table { 0_s };
+		table.Put("Currents", std::vector<double>(24, 1.5));
+		LogTable copy = table.Snapshot(CycleArena::Acquire());
+		idleBefore = CycleArena::GetPoolStats().idleArenas;
+	}
+	CycleArena::PoolStats stats = CycleArena::GetPoolStats();
+	EXPECT_EQ(stats.idleArenas, idleBefore + 1);
+	EXPECT_GT(stats.lastCycleBytes, 0u);
+}
+
+TEST(CycleArenaTest, UnchangedChunksDoNotHoldArena) {
+	LogTable table { 0_s };
+	table.Put("Pinned/Currents", std::vector<double>(24, 1.5));
+	std::weak_ptr<CycleArena> first;
+	{
+		auto arena = CycleArena::Acquire();
+		first = arena;
+		LogTable snapshot = table.Snapshot(std::move(arena));
+	}
+	// The table keeps the chunk to share with the next snapshot
+	EXPECT_FALSE(first.expired());
+
+	LogTable next = table.Snapshot(CycleArena::Acquire());
+	EXPECT_TRUE(first.expired());
+	EXPECT_EQ(next.Get("Pinned/Currents", std::vector<double> { }),
+			std::vector<double>(24, 1.5));
+}
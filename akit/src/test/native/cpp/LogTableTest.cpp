@@ -0,0 +1,282 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <gtest/gtest.h>
+#include <frc/geometry/Pose2d.h>
+#include <frc/util/Color.h>
+#include "akit/LogTable.h"
+
+using namespace akit;
+
+// Defined in AllocationCounter.cpp
+size_t GetAllocationCount();
+
+namespace {
+
+class TestInputs: public inputs::LoggableInputs {
+public:
+	double velocity = 0;
+
+	void ToLog(LogTable &&table) override {
+		table.Put("Velocity", velocity);
+	}
+
+	void FromLog(LogTable &&table) override {
+		velocity = table.Get("Velocity", velocity);
+	}
+};
+
+}
+
+TEST(LogTableTest, SubtableWritesReachParent) {
+	LogTable table { 0_s };
+	table.GetSubtable("Drive").Put("LeftVelocity", 1.5);
+	table.GetSubtable("Drive").GetSubtable("Module0").Put("Angle", 2L);
+
+	EXPECT_EQ(table.Get("Drive/LeftVelocity", 0.0), 1.5);
+	EXPECT_EQ(table.Get("Drive/Module0/Angle", 0L), 2);
+	EXPECT_EQ(table.GetSubtable("Drive").Get("Module0/Angle", 0L), 2);
+}
+
+TEST(LogTableTest, SubtableSharesTimestamp) {
+	LogTable table { 1_s };
+	LogTable subtable = table.GetSubtable("Drive");
+	table.SetTimestamp(2_s);
+	EXPECT_EQ(subtable.GetTimestamp(), 2_s);
+}
+
+TEST(LogTableTest, LoggableInputsRoundTrip) {
+	LogTable table { 0_s };
+	TestInputs inputs;
+	inputs.velocity = 3.0;
+	inputs.ToLog(table.GetSubtable("Drive"));
+	EXPECT_EQ(table.Get("Drive/Velocity", 0.0), 3.0);
+
+	TestInputs replayed;
+	replayed.FromLog(table.GetSubtable("Drive"));
+	EXPECT_EQ(replayed.velocity, 3.0);
+}
+
+TEST(LogTableTest, CopyIsIndependent) {
+	LogTable table { 0_s };
+	table.Put("Value", 1.0);
+	LogTable copy = table;
+	table.Put("Value", 2.0);
+	copy.GetSubtable("Nested").Put("Value", 3.0);
+
+	EXPECT_EQ(copy.Get("Value", 0.0), 1.0);
+	EXPECT_EQ(table.Get("Value", 0.0), 2.0);
+	EXPECT_EQ(table.Get("Nested/Value", 0.0), 0.0);
+}
+
+TEST(LogTableTest, SnapshotIsUnaffectedByLaterWrites) {
+	LogTable table { 1_s };
+	table.Put("Value", 1.0);
+	table.Put("Other", 5.0);
+	LogTable first = table.Snapshot(CycleArena::Acquire());
+
+	table.SetTimestamp(2_s);
+	table.Put("Value", 2.0);
+	LogTable second = table.Snapshot(CycleArena::Acquire());
+	first.Put("Value", 3.0);
+
+	EXPECT_EQ(first.GetTimestamp(), 1_s);
+	EXPECT_EQ(first.Get("Value", 0.0), 3.0);
+	EXPECT_EQ(second.GetTimestamp(), 2_s);
+	EXPECT_EQ(second.Get("Value", 0.0), 2.0);
+	EXPECT_EQ(second.Get("Other", 0.0), 5.0);
+	EXPECT_EQ(table.Get("Value", 0.0), 2.0);
+}
+
+TEST(LogTableTest, ChangesSinceRevision) {
+	LogTable table { 0_s };
+	table.Put("Changed", 1.0);
+	table.Put("Unchanged", 1.0);
+	uint64_t revision = table.Snapshot(CycleArena::Acquire()).GetRevision();
+
+	table.Put("Changed", 2.0);
+	table.Put("Unchanged", 1.0);
+	table.Put("Added", true);
+	LogTable snapshot = table.Snapshot(CycleArena::Acquire());
+
+	std::vector<std::string> changes;
+	snapshot.ForEachChange(revision,
+			[&](KeyRegistry::FieldId id, const LogTable::LogValue&) {
+				changes.push_back(KeyRegistry::GetKey(id));
+			});
+	EXPECT_EQ(changes, (std::vector<std::string> { "/Changed", "/Added" }));
+}
+
+TEST(LogTableTest, StructPutAddsSchemasOnce) {
+	LogTable table { 0_s };
+	table.Put("Pose", frc::Pose2d { });
+	uint64_t revision = table.Snapshot(CycleArena::Acquire()).GetRevision();
+	table.Put("Pose", frc::Pose2d { units::meter_t { 1 }, units::meter_t {
+			2 }, frc::Rotation2d { } });
+
+	EXPECT_EQ(table.Get("Pose").GetCustomTypeStr(), "struct:Pose2d");
+	EXPECT_EQ(table.Get(".schema/struct:Pose2d").GetCustomTypeStr(),
+			"structschema");
+	EXPECT_EQ(table.Get(".schema/struct:Translation2d").GetCustomTypeStr(),
+			"structschema");
+
+	size_t changes = 0;
+	table.ForEachChange(revision,
+			[&](KeyRegistry::FieldId, const LogTable::LogValue&) {
+				changes++;
+			});
+	EXPECT_EQ(changes, 1u);
+}
+
+TEST(LogTableTest, StructArrayRoundTrip) {
+	LogTable table { 0_s };
+	std::vector<frc::Pose2d> trajectory;
+	for (int i = 0; i < 100; i++)
+		trajectory.emplace_back(units::meter_t { i * 0.1 }, units::meter_t {
+				i * 0.2 }, frc::Rotation2d { units::radian_t { i * 0.01 } });
+	table.Put("Trajectory", trajectory);
+	table.Put("Pair", std::array<frc::Pose2d, 2> { trajectory[0],
+			trajectory[1] });
+
+	EXPECT_EQ(table.Get("Trajectory").GetCustomTypeStr(), "struct:Pose2d[]");
+	EXPECT_EQ(table.Get("Trajectory", std::vector<frc::Pose2d> { }),
+			trajectory);
+	auto pair = table.Get("Pair", std::array<frc::Pose2d, 2> { });
+	EXPECT_EQ(pair[1], trajectory[1]);
+	EXPECT_EQ(table.Get("Pair", std::vector<frc::Pose2d> { }).size(), 2u);
+}
+
+TEST(LogTableTest, HandleWritesField) {
+	LogTable table { 0_s };
+	auto velocity = table.GetSubtable("Drive").Register<double>("Velocity");
+	auto enabled = table.Register<bool>("Enabled");
+	velocity.Set(1.5);
+	enabled.Set(true);
+
+	EXPECT_EQ(table.Get("Drive/Velocity", 0.0), 1.5);
+	EXPECT_EQ(table.Get("Enabled", false), true);
+	EXPECT_EQ(table.Get("Enabled").type, LogTable::LoggableType::Boolean);
+	EXPECT_EQ(velocity.Get(0.0), 1.5);
+	table.Put("Drive/Velocity", 2.5);
+	EXPECT_EQ(velocity.Get(0.0), 2.5);
+	EXPECT_EQ(table.Register<double>("Missing").Get(-1.0), -1.0);
+}
+
+TEST(LogTableTest, HandleWithMismatchedTypeIsIgnored) {
+	LogTable table { 0_s };
+	table.Put("Value", std::string { "text" });
+	auto handle = table.Register<double>("Value");
+	handle.Set(1.0);
+	EXPECT_EQ(table.Get("Value", std::string { }), "text");
+}
+
+TEST(LogTableTest, PutFieldConvertsLikePut) {
+	LogTable table { 0_s };
+	const char *mode = "Auto";
+	table.PutField(table.GetFieldId("Mode"), mode);
+	table.PutField(table.GetFieldId("Color"), frc::Color { "#FF0000" });
+
+	EXPECT_EQ(table.Get("Mode").type, LogTable::LoggableType::String);
+	EXPECT_EQ(table.Get("Mode", std::string { }), "Auto");
+	EXPECT_EQ(table.Get("Color", std::string { }), "#FF0000");
+	EXPECT_EQ(
+			table.GetField(table.GetFieldId("Color"), frc::Color { }).HexString(),
+			"#FF0000");
+}
+
+TEST(LogTableTest, ForEachDoesNotAllocate) {
+	LogTable table { 0_s };
+	for (int i = 0; i < 2000; i++)
+		table.GetSubtable(i % 2 ? "Odd" : "Even").Put(
+				"Field" + std::to_string(i), static_cast<double>(i));
+	LogTable subtable = table.GetSubtable("Odd");
+
+	size_t fields = 0, subtableFields = 0;
+	size_t allocationsBefore = GetAllocationCount();
+	table.ForEach(false, [&](std::string_view, const LogTable::LogValue&) {
+		fields++;
+	});
+	subtable.ForEach(true, [&](std::string_view key,
+			const LogTable::LogValue&) {
+		subtableFields += key.starts_with("Field");
+	});
+	size_t allocations = GetAllocationCount() - allocationsBefore;
+
+	EXPECT_EQ(allocations, 0u);
+	EXPECT_GE(fields, 2000u);
+	EXPECT_EQ(subtableFields, 1000u);
+}
+
+TEST(LogTableTest, NestedArrayRoundTrip) {
+	LogTable table { 0_s };
+	std::vector<std::vector<double>> targets;
+	for (int i = 0; i < 300; i++)
+		targets.push_back( { i * 1.0, i * 2.0, i * 3.0 });
+	table.GetSubtable("Camera").Put("Targets", targets);
+
+	EXPECT_EQ(table.Get("Camera/Targets/length", 0L), 300);
+	EXPECT_EQ(table.Get("Camera/Targets/299", std::vector<double> { }),
+			targets[299]);
+	EXPECT_EQ(
+			table.GetSubtable("Camera").Get("Targets",
+					std::vector<std::vector<double>> { }), targets);
+
+	targets.resize(2);
+	table.GetSubtable("Camera").Put("Targets", targets);
+	EXPECT_EQ(table.Get("Camera/Targets", std::vector<std::vector<double>> { }),
+			targets);
+	EXPECT_TRUE(table.Get("Missing", std::vector<std::vector<double>> { }).empty());
+}
+
+TEST(LogTableTest, NestedArrayFromRows) {
+	// A replay source only writes the length and rows, so the base key has
+	// never been interned
+	LogTable table { 0_s };
+	table.Put("ReplayedRows/Targets/length", 2L);
+	table.Put("ReplayedRows/Targets/0", std::vector<double> { 1, 2 });
+	table.Put("ReplayedRows/Targets/1", std::vector<double> { 3 });
+	EXPECT_EQ(
+			table.GetSubtable("ReplayedRows").Get("Targets",
+					std::vector<std::vector<double>> { }),
+			(std::vector<std::vector<double>> { { 1, 2 }, { 3 } }));
+}
+
+TEST(LogTableTest, NestedStructArrayRoundTrip) {
+	LogTable table { 0_s };
+	std::vector<std::vector<frc::Pose2d>> paths { { frc::Pose2d { } }, {
+			frc::Pose2d { units::meter_t { 1 }, units::meter_t { 2 },
+					frc::Rotation2d { } }, frc::Pose2d { } } };
+	table.Put("Paths", paths);
+
+	EXPECT_EQ(table.Get("Paths/1").GetCustomTypeStr(), "struct:Pose2d[]");
+	EXPECT_EQ(table.Get("Paths", std::vector<std::vector<frc::Pose2d>> { }),
+			paths);
+}
+
+TEST(LogTableTest, SamplesMoveToNextSnapshot) {
+	LogTable table { 1_s };
+	KeyRegistry::FieldId id = KeyRegistry::GetId("/Odometry/Yaw");
+	table.AddSample( { 0.004_s, id, LogTable::LogValue { 1.0, "" } });
+	table.AddSample( { 0.008_s, id, LogTable::LogValue { 1.0, "" } });
+	table.AddSample( { 0.012_s, id, LogTable::LogValue { 2.0, "" } });
+	EXPECT_EQ(table.Get("Odometry/Yaw", 0.0), 2.0);
+
+	std::vector<units::second_t> timestamps;
+	LogTable snapshot = table.Snapshot(CycleArena::Acquire());
+	snapshot.ForEachSample([&](const LogTable::Sample &sample) {
+		timestamps.push_back(sample.timestamp);
+	});
+	EXPECT_EQ(timestamps,
+			(std::vector<units::second_t> { 0.004_s, 0.012_s }));
+
+	size_t laterSamples = 0;
+	table.Snapshot(CycleArena::Acquire()).ForEachSample(
+			[&](const LogTable::Sample&) {
+				laterSamples++;
+			});
+	EXPECT_EQ(laterSamples, 0u);
+}
@@ -0,0 +1,215 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <gtest/gtest.h>
+#include "akit/Logger.h"
+#include "akit/inputs/AutoLogInputs.h"
+
+using namespace akit;
+
+namespace {
+
+class GyroInputs: public inputs::LoggableInputs {
+public:
+	double yaw = 0;
+
+	AKIT_AUTOLOG_INPUTS(yaw)
+};
+
+// Replays yaw = offset + cycle
+class GyroSource: public LogReplaySource {
+public:
+	GyroSource(double offset, int64_t cycles) : offset { offset }, cycles {
+			cycles } {
+	}
+
+	void Start() override {
+	}
+
+	bool UpdateTable(LogTable &table) override {
+		if (cycle >= cycles)
+			return false;
+		table.SetTimestamp(units::second_t { cycle * 0.02 });
+		table.Put("Gyro/Yaw", offset + cycle);
+		cycle++;
+		return true;
+	}
+
+private:
+	const double offset;
+	const int64_t cycles;
+	int64_t cycle = 0;
+};
+
+// Collects the replayed output and the context its thread is bound to
+class OutputReceiver: public LogDataReceiver {
+public:
+	OutputReceiver(std::vector<double> &outputs,
+			std::vector<LoggerContext*> &contexts) : outputs { outputs }, contexts {
+			contexts } {
+	}
+
+	void Start() override {
+	}
+
+	void End() override {
+	}
+
+	void PutTable(LogTable &table) override {
+		auto yaw = table.Get("ReplayOutputs/Yaw", -1.0);
+		if (yaw >= 0) {
+			outputs.push_back(yaw);
+			contexts.push_back(&LoggerContext::GetCurrent());
+		}
+	}
+
+private:
+	std::vector<double> &outputs;
+	std::vector<LoggerContext*> &contexts;
+};
+
+// Collects outputs recorded by a worker thread
+class WorkerReceiver: public LogDataReceiver {
+public:
+	void Start() override {
+	}
+
+	void End() override {
+	}
+
+	void PutTable(LogTable &table) override {
+		keyed = table.Get("RealOutputs/Worker/Keyed", keyed);
+		handled = table.Get("RealOutputs/Worker/Handled", handled);
+	}
+
+	double keyed = 0;
+	double handled = 0;
+};
+
+// Runs a replay through the static Logger API, like robot code would
+void Replay(LoggerContext &context, double offset, int64_t cycles,
+		std::vector<double> &outputs, std::vector<LoggerContext*> &contexts) {
+	LoggerContext::Scope scope { context };
+	Logger::AdvancedHooks::DisableRobotBaseCheck();
+	Logger::SetReplaySource(std::make_unique < GyroSource > (offset, cycles));
+	Logger::AddDataReceiver(
+			std::make_unique < OutputReceiver > (outputs, contexts));
+	Logger::Start();
+	GyroInputs inputs;
+	while (context.IsRunning()) {
+		Logger::ProcessInputs("Gyro", inputs);
+		Logger::RecordOutput("Yaw", inputs.yaw);
+		Logger::PeriodicAfterUser(0_ms, 0_ms);
+		Logger::PeriodicBeforeUser();
+	}
+}
+
+}
+
+TEST(LoggerContextTest, ScopeBindsContext) {
+	LoggerContext context;
+	EXPECT_EQ(&Logger::GetContext(), &LoggerContext::GetDefault());
+	{
+		LoggerContext::Scope scope { context };
+		EXPECT_EQ(&Logger::GetContext(), &context);
+		{
+			LoggerContext nested;
+			LoggerContext::Scope nestedScope { nested };
+			EXPECT_EQ(&Logger::GetContext(), &nested);
+		}
+		EXPECT_EQ(&Logger::GetContext(), &context);
+	}
+	EXPECT_EQ(&Logger::GetContext(), &LoggerContext::GetDefault());
+}
+
+TEST(LoggerContextTest, ParallelReplaysAreIsolated) {
+	constexpr int64_t cycles = 200;
+	LoggerContext first, second;
+	std::vector<double> firstOutputs, secondOutputs;
+	std::vector<LoggerContext*> firstContexts, secondContexts;
+	std::thread firstThread { [&] {
+		Replay(first, 0, cycles, firstOutputs, firstContexts);
+	} };
+	std::thread secondThread { [&] {
+		Replay(second, 1000, cycles, secondOutputs, secondContexts);
+	} };
+	firstThread.join();
+	secondThread.join();
+
+	ASSERT_EQ(firstOutputs.size(), static_cast<size_t>(cycles));
+	ASSERT_EQ(secondOutputs.size(), static_cast<size_t>(cycles));
+	for (int64_t cycle = 0; cycle < cycles; cycle++) {
+		EXPECT_EQ(firstOutputs[cycle], cycle);
+		EXPECT_EQ(secondOutputs[cycle], 1000 + cycle);
+		EXPECT_EQ(firstContexts[cycle], &first);
+		EXPECT_EQ(secondContexts[cycle], &second);
+	}
+	EXPECT_FALSE(first.IsRunning());
+	EXPECT_FALSE(second.IsRunning());
+}
+
+TEST(LoggerContextTest, StartAfterEnd) {
+	LoggerContext context;
+	LoggerContext::Scope scope { context };
+	std::vector<double> outputs;
+	std::vector<LoggerContext*> contexts;
+	Logger::AdvancedHooks::DisableRobotBaseCheck();
+	Logger::AddDataReceiver(
+			std::make_unique < OutputReceiver > (outputs, contexts));
+
+	// The receiver added before the first session logs both
+	for (double offset : { 0.0, 1000.0 }) {
+		Logger::SetReplaySource(std::make_unique < GyroSource > (offset, 5));
+		Logger::Start();
+		GyroInputs inputs;
+		while (context.IsRunning()) {
+			Logger::ProcessInputs("Gyro", inputs);
+			Logger::RecordOutput("Yaw", inputs.yaw);
+			Logger::PeriodicAfterUser(0_ms, 0_ms);
+			Logger::PeriodicBeforeUser();
+		}
+	}
+	EXPECT_EQ(outputs,
+			(std::vector<double> { 0, 1, 2, 3, 4, 1000, 1001, 1002, 1003, 1004 }));
+}
+
+TEST(LoggerContextTest, WorkerReadsFirstReplayedCycle) {
+	LoggerContext context;
+	context.DisableRobotBaseCheck();
+	context.SetReplaySource(std::make_unique < GyroSource > (100, 3));
+	context.Start();
+
+	// The first read off the logging thread already sees the first cycle
+	GyroInputs inputs;
+	std::thread worker { [&] {
+		LoggerContext::Scope scope { context };
+		Logger::ProcessInputs("Gyro", inputs);
+	} };
+	worker.join();
+	EXPECT_EQ(inputs.yaw, 100);
+	context.End();
+}
+
+TEST(LoggerContextTest, WorkerOutputsAreMerged) {
+	LoggerContext context;
+	context.DisableRobotBaseCheck();
+	auto receiver = std::make_unique<WorkerReceiver>();
+	WorkerReceiver &received = *receiver;
+	context.AddDataReceiver(std::move(receiver));
+	auto handle = context.RegisterOutput<double>("Worker/Handled");
+	context.Start();
+
+	std::thread worker { [&] {
+		context.RecordOutput("Worker/Keyed", 1.5);
+		context.RecordOutput(handle, 2.5);
+	} };
+	worker.join();
+	context.PeriodicAfterUser(0_ms, 0_ms);
+	context.End();
+	EXPECT_EQ(received.keyed, 1.5);
+	EXPECT_EQ(received.handled, 2.5);
+}
@@ -0,0 +1,74 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <chrono>
+#include <numeric>
+#include <thread>
+#include <gtest/gtest.h>
+#include "akit/PeriodicScheduler.h"
+
+using namespace akit;
+
+TEST(PeriodicSchedulerTest, SamePeriodTasksRunOnDifferentCycles) {
+	PeriodicScheduler scheduler;
+	std::vector<int> runs(5);
+	for (int i = 0; i < 5; i++)
+		scheduler.Add("SamePeriod" + std::to_string(i), 5, [&runs, i] {
+			runs[i]++;
+		});
+
+	for (int cycle = 0; cycle < 50; cycle++) {
+		int before = std::accumulate(runs.begin(), runs.end(), 0);
+		scheduler.Run();
+		EXPECT_EQ(std::accumulate(runs.begin(), runs.end(), 0), before + 1);
+	}
+	for (int count : runs)
+		EXPECT_EQ(count, 10);
+}
+
+TEST(PeriodicSchedulerTest, MixedPeriodsAreSpread) {
+	PeriodicScheduler scheduler;
+	int runsThisCycle = 0;
+	for (int i = 0; i < 2; i++)
+		scheduler.Add("Fast" + std::to_string(i), 10, [&] {
+			runsThisCycle++;
+		});
+	for (int i = 0; i < 5; i++)
+		scheduler.Add("Slow" + std::to_string(i), 50, [&] {
+			runsThisCycle++;
+		});
+
+	for (int cycle = 0; cycle < 100; cycle++) {
+		runsThisCycle = 0;
+		scheduler.Run();
+		EXPECT_LE(runsThisCycle, 1);
+	}
+}
+
+TEST(PeriodicSchedulerTest, RebalanceSeparatesExpensiveTasks) {
+	PeriodicScheduler scheduler;
+	auto expensive = scheduler.Add("Expensive", 2, [] {
+		std::this_thread::sleep_for(std::chrono::milliseconds { 2 });
+	});
+	auto cheapA = scheduler.Add("CheapA", 2, [] {
+	});
+	auto cheapB = scheduler.Add("CheapB", 2, [] {
+	});
+	// With no costs measured yet, tasks are spread by count alone
+	EXPECT_EQ(scheduler.GetStats()[expensive].phase,
+			scheduler.GetStats()[cheapB].phase);
+
+	for (int cycle = 0; cycle < 4; cycle++)
+		scheduler.Run();
+	scheduler.Rebalance();
+
+	auto stats = scheduler.GetStats();
+	EXPECT_NE(stats[expensive].phase, stats[cheapA].phase);
+	EXPECT_NE(stats[expensive].phase, stats[cheapB].phase);
+	EXPECT_GE(stats[expensive].cost, 2_ms);
+	EXPECT_LT(scheduler.GetPredictedPeak(), stats[expensive].cost * 1.5);
+}
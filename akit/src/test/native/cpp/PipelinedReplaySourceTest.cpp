@@ -0,0 +1,155 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include "akit/PipelinedReplaySource.h"
+
+using namespace akit;
+
+namespace {
+
+// Replays a fixed number of cycles. Some fields change every cycle, some
+// only occasionally, and one is written once.
+class CountingSource: public LogReplaySource {
+public:
+	explicit CountingSource(int64_t cycles) : cycles { cycles } {
+	}
+
+	void Start() override {
+	}
+
+	bool UpdateTable(LogTable &table) override {
+		if (cycle >= cycles)
+			return false;
+		table.SetTimestamp(units::second_t { cycle * 0.02 });
+		table.Put("ReplayTest/Cycle", cycle);
+		table.Put("ReplayTest/Slow", cycle / 5);
+		if (cycle == 3)
+			table.Put("ReplayTest/Once", std::string { "three" });
+		table.Put("ReplayTest/Values",
+				std::vector<double> { static_cast<double>(cycle), 1.0 });
+		cycle++;
+		return true;
+	}
+
+	bool Seek(units::second_t timestamp) override {
+		if (!seekable)
+			return false;
+		cycle = std::llround(timestamp.value() / 0.02);
+		return true;
+	}
+
+	bool seekable = true;
+
+private:
+	const int64_t cycles;
+	int64_t cycle = 0;
+};
+
+}
+
+TEST(PipelinedReplaySourceTest, MatchesWrappedSource) {
+	CountingSource direct { 50 };
+	PipelinedReplaySource pipelined { std::make_unique < CountingSource
+			> (50), 4 };
+	direct.Start();
+	pipelined.Start();
+
+	LogTable directTable { 0_s };
+	LogTable pipelinedTable { 0_s };
+	for (int i = 0; i < 50; i++) {
+		ASSERT_TRUE(direct.UpdateTable(directTable));
+		ASSERT_TRUE(pipelined.UpdateTable(pipelinedTable));
+		// User code writes outputs between cycles
+		pipelinedTable.Put("ReplayOutputs/Cycle", i);
+		directTable.Put("ReplayOutputs/Cycle", i);
+
+		EXPECT_EQ(pipelinedTable.GetTimestamp(), directTable.GetTimestamp());
+		EXPECT_EQ(pipelinedTable.GetAll(false), directTable.GetAll(false));
+	}
+	EXPECT_FALSE(direct.UpdateTable(directTable));
+	EXPECT_FALSE(pipelined.UpdateTable(pipelinedTable));
+}
+
+TEST(PipelinedReplaySourceTest, DecodesAhead) {
+	PipelinedReplaySource pipelined { std::make_unique < CountingSource
+			> (100), 8 };
+	pipelined.Start();
+	LogTable table { 0_s };
+	ASSERT_TRUE(pipelined.UpdateTable(table));
+	while (pipelined.GetQueuedCycles() < 8)
+		std::this_thread::yield();
+	EXPECT_EQ(pipelined.GetQueuedCycles(), 8u);
+}
+
+TEST(PipelinedReplaySourceTest, DestroyWhileDecoding) {
+	// The decode thread is blocked on a full queue and must still stop
+	PipelinedReplaySource pipelined { std::make_unique < CountingSource
+			> (1000), 2 };
+	pipelined.Start();
+	LogTable table { 0_s };
+	EXPECT_TRUE(pipelined.UpdateTable(table));
+}
+
+TEST(PipelinedReplaySourceTest, SeekDiscardsDecodedCycles) {
+	PipelinedReplaySource pipelined { std::make_unique < CountingSource
+			> (100), 8 };
+	pipelined.Start();
+	LogTable table { 0_s };
+	ASSERT_TRUE(pipelined.UpdateTable(table));
+	while (pipelined.GetQueuedCycles() < 8)
+		std::this_thread::yield();
+
+	ASSERT_TRUE(pipelined.Seek(1_s));
+	ASSERT_TRUE(pipelined.UpdateTable(table));
+	EXPECT_DOUBLE_EQ(table.GetTimestamp().value(), 1.0);
+	EXPECT_EQ(table.Get("ReplayTest/Cycle", -1L), 50);
+	int cycles = 1;
+	while (pipelined.UpdateTable(table))
+		cycles++;
+	EXPECT_EQ(cycles, 50);
+	EXPECT_EQ(table.Get("ReplayTest/Cycle", -1L), 99);
+}
+
+TEST(PipelinedReplaySourceTest, FailedSeekKeepsPosition) {
+	auto source = std::make_unique < CountingSource > (20);
+	source->seekable = false;
+	PipelinedReplaySource pipelined { std::move(source), 4 };
+	pipelined.Start();
+	LogTable table { 0_s };
+	ASSERT_TRUE(pipelined.UpdateTable(table));
+	EXPECT_FALSE(pipelined.Seek(0.2_s));
+	for (long cycle = 1; cycle < 20; cycle++) {
+		ASSERT_TRUE(pipelined.UpdateTable(table));
+		EXPECT_EQ(table.Get("ReplayTest/Cycle", -1L), cycle);
+	}
+	EXPECT_FALSE(pipelined.UpdateTable(table));
+}
+
+TEST(PipelinedReplaySourceTest, SeekRemovesFieldsMissingAtTarget) {
+	PipelinedReplaySource pipelined { std::make_unique < CountingSource
+			> (20), 4 };
+	pipelined.Start();
+	LogTable table { 0_s };
+	for (int cycle = 0; cycle < 5; cycle++)
+		ASSERT_TRUE(pipelined.UpdateTable(table));
+	table.Put("ReplayOutputs/Cycle", 4);
+	ASSERT_EQ(table.Get("ReplayTest/Once", std::string { }), "three");
+
+	// "Once" is only written at cycle 3, so it does not exist at cycle 1
+	ASSERT_TRUE(pipelined.Seek(0.02_s));
+	ASSERT_TRUE(pipelined.UpdateTable(table));
+	EXPECT_EQ(table.Get("ReplayTest/Cycle", -1L), 1);
+	EXPECT_FALSE(table.GetAll(false).contains("/ReplayTest/Once"));
+	// Outputs written by the robot code are kept
+	EXPECT_EQ(table.Get("ReplayOutputs/Cycle", -1L), 4);
+
+	for (int cycle = 2; cycle < 5; cycle++)
+		ASSERT_TRUE(pipelined.UpdateTable(table));
+	EXPECT_EQ(table.Get("ReplayTest/Once", std::string { }), "three");
+}
@@ -0,0 +1,82 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include "akit/Profiler.h"
+
+using namespace akit;
+
+namespace {
+
+double GetMS(LogTable &table, std::string key) {
+	return table.Get(std::move(key), units::millisecond_t { -1 }).value();
+}
+
+}
+
+TEST(ProfilerTest, NestedSpansAreLoggedByName) {
+	LogTable table { 0_s };
+	{
+		AKIT_PROFILE("ProfilerTest/Outer");
+		AKIT_PROFILE("ProfilerTest/Outer/Inner");
+	}
+	Profiler::Flush(table.GetSubtable("Profiling"));
+
+	double outer = GetMS(table, "Profiling/ProfilerTest/OuterMS");
+	double inner = GetMS(table, "Profiling/ProfilerTest/Outer/InnerMS");
+	EXPECT_GE(inner, 0);
+	EXPECT_GE(outer, inner);
+}
+
+TEST(ProfilerTest, RepeatedSpansAddUpWithinCycle) {
+	Profiler::SpanId id = Profiler::RegisterSpan("ProfilerTest/Repeated");
+	EXPECT_EQ(Profiler::RegisterSpan("ProfilerTest/Repeated"), id);
+
+	double total = 0;
+	for (int i = 0; i < 3; i++) {
+		Profiler::Span span { id };
+		total += span.End().value();
+	}
+	LogTable table { 0_s };
+	Profiler::Flush(table.GetSubtable("Profiling"));
+	EXPECT_DOUBLE_EQ(GetMS(table, "Profiling/ProfilerTest/RepeatedMS"), total);
+}
+
+TEST(ProfilerTest, EndRecordsOnce) {
+	LogTable table { 0_s };
+	double duration;
+	{
+		AKIT_PROFILE_SPAN(span, "ProfilerTest/EndedEarly");
+		duration = span.End().value();
+		EXPECT_EQ(span.End().value(), duration);
+	}
+	Profiler::Flush(table.GetSubtable("Profiling"));
+	EXPECT_DOUBLE_EQ(GetMS(table, "Profiling/ProfilerTest/EndedEarlyMS"),
+			duration);
+}
+
+TEST(ProfilerTest, StatisticsCoverRecentCycles) {
+	Profiler::SpanId id = Profiler::RegisterSpan("ProfilerTest/Window");
+	LogTable table { 0_s };
+	std::vector<double> durations;
+	for (size_t cycle = 0; cycle < Profiler::WINDOW_CYCLES + 50; cycle++) {
+		Profiler::Span span { id };
+		durations.push_back(span.End().value());
+		Profiler::Flush(table.GetSubtable("Profiling"));
+	}
+
+	std::vector<double> window { durations.end() - Profiler::WINDOW_CYCLES,
+			durations.end() };
+	std::sort(window.begin(), window.end());
+	EXPECT_DOUBLE_EQ(GetMS(table, "Profiling/ProfilerTest/WindowMS"), durations.back());
+	EXPECT_DOUBLE_EQ(GetMS(table, "Profiling/ProfilerTest/Window/P50MS"),
+			window[(window.size() - 1) / 2]);
+	EXPECT_DOUBLE_EQ(GetMS(table, "Profiling/ProfilerTest/Window/P99MS"),
+			window[247]);
+	EXPECT_DOUBLE_EQ(GetMS(table, "Profiling/ProfilerTest/Window/MaxMS"), window.back());
+}
@@ -0,0 +1,192 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <chrono>
+#include <thread>
+#include <gtest/gtest.h>
+#include "akit/CycleArena.h"
+#include "akit/LogDataReceiver.h"
+#include "akit/ReceiverQueue.h"
+
+using namespace akit;
+
+namespace {
+
+// Writes changed fields like the real receivers, taking delay per table
+class SlowReceiver: public LogDataReceiver {
+public:
+	explicit SlowReceiver(std::chrono::milliseconds delay = { }) : delay {
+			delay } {
+	}
+
+	void Start() override {
+	}
+
+	void End() override {
+	}
+
+	void PutTable(LogTable &table) override {
+		std::this_thread::sleep_for(delay);
+		table.ForEachChange(lastRevision,
+				[&](KeyRegistry::FieldId id, const LogTable::LogValue &value) {
+					received.Put(KeyRegistry::GetKey(id).substr(1), value);
+				});
+		lastRevision = table.GetRevision();
+		tableCount++;
+	}
+
+	LogTable received { 0_s };
+	size_t tableCount = 0;
+
+private:
+	std::chrono::milliseconds delay;
+	uint64_t lastRevision = 0;
+};
+
+void RunCycles(LogTable &table, ReceiverQueue &queue, int64_t count) {
+	for (int64_t cycle = 0; cycle < count; cycle++) {
+		table.Put("QueueTest/Cycle", cycle);
+		if (cycle == 1)
+			table.Put("QueueTest/Once", true);
+		queue.Enqueue(table.Snapshot(CycleArena::Acquire()));
+	}
+}
+
+void Drain(ReceiverQueue &queue, SlowReceiver &receiver) {
+	while (queue.GetStats().size > 0) {
+		std::optional < LogTable > entry = queue.Dequeue();
+		receiver.PutTable(*entry);
+	}
+}
+
+}
+
+TEST(ReceiverQueueTest, DropNewestDiscardsWhenFull) {
+	ReceiverQueue queue { 4 };
+	LogTable table { 0_s };
+	RunCycles(table, queue, 10);
+
+	ReceiverQueue::Stats stats = queue.GetStats();
+	EXPECT_EQ(stats.size, 4u);
+	EXPECT_EQ(stats.highWater, 4u);
+	EXPECT_EQ(stats.droppedCycles, 6u);
+
+	SlowReceiver receiver;
+	Drain(queue, receiver);
+	EXPECT_EQ(receiver.received.Get("QueueTest/Cycle", int64_t { -1 }), 3);
+}
+
+TEST(ReceiverQueueTest, DropOldestKeepsLatestValues) {
+	ReceiverQueue queue { 4 };
+	queue.SetPolicy(ReceiverQueue::Policy::DROP_OLDEST);
+	LogTable table { 0_s };
+	RunCycles(table, queue, 10);
+	EXPECT_EQ(queue.GetStats().droppedCycles, 6u);
+
+	// The field written only in a dropped cycle still arrives
+	SlowReceiver receiver;
+	Drain(queue, receiver);
+	EXPECT_EQ(receiver.tableCount, 4u);
+	EXPECT_EQ(receiver.received.Get("QueueTest/Cycle", int64_t { -1 }), 9);
+	EXPECT_TRUE(receiver.received.Get("QueueTest/Once", false));
+}
+
+TEST(ReceiverQueueTest, CoalesceMergesIntoNewestCycle) {
+	ReceiverQueue queue { 1 };
+	queue.SetPolicy(ReceiverQueue::Policy::COALESCE);
+	LogTable table { 0_s };
+	RunCycles(table, queue, 10);
+
+	ReceiverQueue::Stats stats = queue.GetStats();
+	EXPECT_EQ(stats.coalescedCycles, 9u);
+	EXPECT_EQ(stats.droppedCycles, 0u);
+
+	SlowReceiver receiver;
+	Drain(queue, receiver);
+	EXPECT_EQ(receiver.tableCount, 1u);
+	EXPECT_EQ(receiver.received.Get("QueueTest/Cycle", int64_t { -1 }), 9);
+	EXPECT_TRUE(receiver.received.Get("QueueTest/Once", false));
+}
+
+TEST(ReceiverQueueTest, BlockWaitsForSlowReceiver) {
+	ReceiverQueue queue { 2 };
+	queue.SetPolicy(ReceiverQueue::Policy::BLOCK_WITH_DEADLINE, 500_ms);
+	SlowReceiver receiver { std::chrono::milliseconds { 2 } };
+	std::thread receiverThread { [&] {
+		for (int i = 0; i < 10; i++) {
+			std::optional < LogTable > entry = queue.Dequeue();
+		receiver.PutTable(*entry);
+		}
+	} };
+
+	LogTable table { 0_s };
+	RunCycles(table, queue, 10);
+	receiverThread.join();
+
+	EXPECT_EQ(queue.GetStats().droppedCycles, 0u);
+	EXPECT_EQ(receiver.tableCount, 10u);
+	EXPECT_EQ(receiver.received.Get("QueueTest/Cycle", int64_t { -1 }), 9);
+}
+
+TEST(ReceiverQueueTest, BlockDropsAfterDeadline) {
+	ReceiverQueue queue { 1 };
+	queue.SetPolicy(ReceiverQueue::Policy::BLOCK_WITH_DEADLINE, 5_ms);
+	LogTable table { 0_s };
+	EXPECT_TRUE(queue.Enqueue(table.Snapshot(CycleArena::Acquire())));
+	EXPECT_FALSE(queue.Enqueue(table.Snapshot(CycleArena::Acquire())));
+
+	ReceiverQueue::Stats stats = queue.GetStats();
+	EXPECT_EQ(stats.droppedCycles, 1u);
+	EXPECT_GE(stats.lastBlockedTime, 5_ms);
+}
+
+TEST(ReceiverQueueTest, BlockWithoutDeadlineNeverDrops) {
+	ReceiverQueue queue { 1 };
+	queue.SetPolicy(ReceiverQueue::Policy::BLOCK);
+	SlowReceiver receiver { std::chrono::milliseconds { 1 } };
+	std::thread receiverThread { [&] {
+		while (std::optional < LogTable > entry = queue.Dequeue())
+		receiver.PutTable(*entry);
+	} };
+
+	LogTable table { 0_s };
+	RunCycles(table, queue, 20);
+	queue.Close();
+	receiverThread.join();
+
+	EXPECT_EQ(queue.GetStats().droppedCycles, 0u);
+	EXPECT_EQ(receiver.tableCount, 20u);
+	EXPECT_EQ(receiver.received.Get("QueueTest/Cycle", int64_t { -1 }), 19);
+}
+
+TEST(ReceiverQueueTest, DegradedUntilDrained) {
+	ReceiverQueue queue { 8 };
+	queue.SetPolicy(ReceiverQueue::Policy::DEGRADE);
+	LogTable table { 0_s };
+	RunCycles(table, queue, 5);
+	EXPECT_FALSE(queue.IsDegraded());
+	RunCycles(table, queue, 1);
+	EXPECT_TRUE(queue.IsDegraded());
+
+	for (int i = 0; i < 3; i++)
+		queue.Dequeue();
+	EXPECT_TRUE(queue.IsDegraded());
+	queue.Dequeue();
+	EXPECT_FALSE(queue.IsDegraded());
+}
+
+TEST(ReceiverQueueTest, CloseWakesReader) {
+	ReceiverQueue queue { 4 };
+	std::thread reader { [&] {
+		EXPECT_FALSE(queue.Dequeue());
+	} };
+	queue.Close();
+	reader.join();
+
+	LogTable table { 0_s };
+	EXPECT_FALSE(queue.Enqueue(table.Snapshot(CycleArena::Acquire())));
+}
@@ -0,0 +1,150 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <future>
+#include <gtest/gtest.h>
+#include "akit/CycleArena.h"
+#include "akit/ReceiverThread.h"
+
+using namespace akit;
+
+namespace {
+
+class CountingReceiver: public LogDataReceiver {
+public:
+	explicit CountingReceiver(std::atomic<size_t> &tableCount,
+			std::shared_future<void> gate = { }, std::atomic<size_t> *endCount =
+					nullptr) : tableCount { tableCount }, gate { std::move(gate) }, endCount {
+			endCount } {
+	}
+
+	void Start() override {
+	}
+
+	void End() override {
+		if (endCount)
+			(*endCount)++;
+	}
+
+	void PutTable(LogTable &table) override {
+		tableCount++;
+		if (gate.valid())
+			gate.wait();
+	}
+
+private:
+	std::atomic<size_t> &tableCount;
+	std::shared_future<void> gate;
+	std::atomic<size_t> *endCount;
+};
+
+}
+
+TEST(ReceiverThreadTest, SlowReceiverDoesNotDelayOthers) {
+	std::promise<void> release;
+	std::atomic<size_t> slowCount = 0, fastCount = 0;
+	{
+		ReceiverThread receivers { 4 };
+		receivers.AddDataReceiver(
+				std::make_unique < CountingReceiver
+						> (slowCount, release.get_future().share()));
+		receivers.AddDataReceiver(
+				std::make_unique < CountingReceiver > (fastCount));
+		receivers.Start();
+
+		LogTable table { 0_s };
+		for (int cycle = 0; cycle < 20; cycle++) {
+			table.SetTimestamp(units::second_t { cycle * 0.02 });
+			table.Put("ReceiverTest/Cycle", cycle);
+			receivers.PutTable(table.Snapshot(CycleArena::Acquire()));
+			while (fastCount < static_cast<size_t>(cycle + 1) || slowCount == 0)
+				std::this_thread::yield();
+		}
+
+		// The slow receiver is still on its first cycle, with four queued
+		auto stats = receivers.GetStats();
+		ASSERT_EQ(stats.size(), 2u);
+		EXPECT_EQ(stats[0].queue.size, 4u);
+		EXPECT_EQ(stats[0].queue.droppedCycles, 15u);
+		EXPECT_NEAR(units::second_t { stats[0].lag }.value(), 0.38, 1e-9);
+		EXPECT_EQ(stats[1].queue.droppedCycles, 0u);
+		EXPECT_EQ(fastCount, 20u);
+
+		// Closing the queues lets the slow receiver finish what it has
+		release.set_value();
+	}
+	EXPECT_EQ(slowCount, 5u);
+}
+
+TEST(ReceiverThreadTest, StopDrainsQueuedCycles) {
+	std::promise<void> release;
+	std::atomic<size_t> tableCount = 0, endCount = 0;
+	ReceiverThread receivers { 10 };
+	receivers.AddDataReceiver(
+			std::make_unique < CountingReceiver
+					> (tableCount, release.get_future().share(), &endCount));
+	receivers.Start();
+
+	LogTable table { 0_s };
+	for (int cycle = 0; cycle < 6; cycle++) {
+		table.Put("ReceiverTest/Cycle", cycle);
+		receivers.PutTable(table.Snapshot(CycleArena::Acquire()));
+	}
+	while (tableCount == 0)
+		std::this_thread::yield();
+
+	// The receiver is stuck on its first cycle until after Stop is called
+	std::thread releaser { [&] {
+		std::this_thread::sleep_for(std::chrono::milliseconds { 20 });
+		release.set_value();
+	} };
+	auto result = receivers.Stop();
+	releaser.join();
+	EXPECT_EQ(result.flushedCycles, 5u);
+	EXPECT_EQ(result.droppedCycles, 0u);
+	EXPECT_EQ(tableCount, 6u);
+	EXPECT_EQ(endCount, 1u);
+	// Cycles after Stop are not accepted
+	EXPECT_FALSE(receivers.PutTable(table));
+	EXPECT_EQ(receivers.Stop().flushedCycles, 0u);
+}
+
+TEST(ReceiverThreadTest, StopDropsCyclesAfterDeadline) {
+	std::promise<void> release;
+	std::atomic<size_t> slowCount = 0, fastCount = 0, endCount = 0;
+	ReceiverThread receivers { 10 };
+	receivers.AddDataReceiver(
+			std::make_unique < CountingReceiver
+					> (slowCount, release.get_future().share(), &endCount));
+	receivers.AddDataReceiver(
+			std::make_unique < CountingReceiver
+					> (fastCount, std::shared_future<void> { }, &endCount));
+	receivers.Start();
+
+	LogTable table { 0_s };
+	for (int cycle = 0; cycle < 6; cycle++) {
+		table.Put("ReceiverTest/Cycle", cycle);
+		receivers.PutTable(table.Snapshot(CycleArena::Acquire()));
+	}
+	while (slowCount == 0)
+		std::this_thread::yield();
+
+	// The slow receiver is stuck on its first cycle, so Stop returns at the
+	// deadline without waiting for it
+	auto result = receivers.Stop(10_ms);
+	EXPECT_EQ(result.droppedCycles, 5u);
+	EXPECT_EQ(slowCount, 1u);
+	EXPECT_EQ(fastCount, 6u);
+	EXPECT_EQ(endCount, 1u);
+	EXPECT_EQ(receivers.GetStats()[0].queue.droppedCycles, 5u);
+
+	// The detached worker ends its receiver once it is released
+	release.set_value();
+	while (endCount < 2)
+		std::this_thread::yield();
+	EXPECT_EQ(slowCount, 1u);
+}
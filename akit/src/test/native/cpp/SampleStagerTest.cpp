@@ -0,0 +1,79 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <thread>
+#include <gtest/gtest.h>
+#include <frc/geometry/Pose2d.h>
+#include "akit/CycleArena.h"
+#include "akit/SampleStager.h"
+
+using namespace akit;
+
+TEST(SampleStagerTest, MergesWritesFromManyThreads) {
+	constexpr int threadCount = 4;
+	constexpr int samplesPerThread = 250;
+	SampleStager stager;
+	LogTable table { 0_s };
+
+	std::vector < std::thread > threads;
+	for (int thread = 0; thread < threadCount; thread++)
+		threads.emplace_back([&stager, thread] {
+			std::string key = "Thread" + std::to_string(thread) + "/Sample";
+			for (int i = 1; i <= samplesPerThread; i++) {
+				LogTable staging { units::second_t { i * 0.004 } };
+				staging.GetSubtable("StagerTest").Put(key, i);
+				stager.Stage(staging);
+			}
+		});
+	// Merging while the threads are still writing is allowed
+	size_t merged = 0;
+	for (auto &thread : threads) {
+		merged += stager.MergeInto(table);
+		thread.join();
+	}
+	merged += stager.MergeInto(table);
+	EXPECT_EQ(merged, static_cast<size_t>(threadCount * samplesPerThread));
+
+	std::vector<int> lastValue(threadCount, 0);
+	LogTable snapshot = table.Snapshot(CycleArena::Acquire());
+	snapshot.ForEachSample([&](const LogTable::Sample &sample) {
+		const std::string &key = KeyRegistry::GetKey(sample.id);
+		int thread = key[std::string { "/StagerTest/Thread" }.size()] - '0';
+		int value = sample.value.GetInteger();
+		// Each thread's samples stay in order, with their own timestamps
+		EXPECT_EQ(value, lastValue[thread] + 1);
+		EXPECT_DOUBLE_EQ(sample.timestamp.value(), value * 0.004);
+		lastValue[thread] = value;
+	});
+	for (int thread = 0; thread < threadCount; thread++) {
+		EXPECT_EQ(lastValue[thread], samplesPerThread);
+		EXPECT_EQ(
+				table.Get("StagerTest/Thread" + std::to_string(thread)
+						+ "/Sample", 0), samplesPerThread);
+	}
+}
+
+TEST(SampleStagerTest, KeysResolveWhenMerged) {
+	SampleStager stager;
+	LogTable table { 0_s };
+	frc::Pose2d pose { units::meter_t { 1 }, units::meter_t { 2 },
+			frc::Rotation2d { } };
+	std::thread writer { [&] {
+		stager.Stage(1_s, "KeyedStage/Pose", pose);
+		stager.Stage(2_s, "KeyedStage/Mode", "Auto");
+	} };
+	writer.join();
+	// The writing thread never touched the registry
+	EXPECT_FALSE(KeyRegistry::FindId("/KeyedStage/Pose"));
+
+	EXPECT_EQ(stager.MergeInto(table), 2u);
+	EXPECT_TRUE(table.Get("KeyedStage/Pose", frc::Pose2d { }) == pose);
+	EXPECT_EQ(table.Get("KeyedStage/Pose").GetCustomTypeStr(), "struct:Pose2d");
+	EXPECT_TRUE(table.Get(".schema/struct:Pose2d").type
+			== LogTable::LoggableType::Raw);
+	EXPECT_EQ(table.Get("KeyedStage/Mode", std::string { }), "Auto");
+}
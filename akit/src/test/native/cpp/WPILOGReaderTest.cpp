@@ -0,0 +1,166 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <cstdlib>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <wpi/DataLogWriter.h>
+#include "akit/wpilog/WPILOGConstants.h"
+#include "akit/wpilog/WPILOGReader.h"
+
+using namespace akit;
+
+namespace {
+
+constexpr int CYCLE_COUNT = 2000;
+
+// Writes a log the way WPILOGWriter does, with cycles 20 ms apart starting
+// at 1 s. "Drive/X" changes every cycle, "Drive/Slow" every 700 cycles and
+// "Mode" is only written in modeCycle.
+std::string MakeLog(int modeCycle = 3) {
+	std::string path = (std::filesystem::temp_directory_path()
+			/ "WPILOGReaderTest.wpilog").string();
+	std::filesystem::remove(path);
+	std::filesystem::remove(path + ".akitindex");
+
+	std::error_code code;
+	wpi::log::DataLogWriter log { path, code,
+			wpilog::WPILOGConstants::EXTRA_HEADER };
+	int timestamp = log.Start("/Timestamp", "int64");
+	int x = log.Start("/Drive/X", "double");
+	int slow = log.Start("/Drive/Slow", "double");
+	int output = log.Start("/ReplayOutputs/Y", "double");
+	for (int cycle = 0; cycle < CYCLE_COUNT; cycle++) {
+		int64_t time = 1000000 + cycle * 20000;
+		log.AppendInteger(timestamp, time, time);
+		log.AppendDouble(x, cycle * 1.5, time);
+		if (cycle % 700 == 0)
+			log.AppendDouble(slow, cycle, time);
+		if (cycle == modeCycle)
+			log.AppendString(log.Start("/Mode", "string", { }, time), "Auto",
+					time);
+		log.AppendDouble(output, -1, time);
+	}
+	log.Flush();
+	return path;
+}
+
+void SetWindow(const char *window) {
+#ifdef _WIN32
+	_putenv_s(wpilog::WPILOGReader::WINDOW_ENV, window);
+#else
+	setenv(wpilog::WPILOGReader::WINDOW_ENV, window, 1);
+#endif
+}
+
+units::second_t CycleTime(int cycle) {
+	return units::second_t { 1 + cycle * 0.02 };
+}
+
+}
+
+TEST(WPILOGReaderTest, SeekMatchesSequentialReplay) {
+	std::string path = MakeLog();
+	wpilog::WPILOGReader sequential { path, false };
+	sequential.Start();
+	LogTable expected { 0_s };
+
+	int cycle = 0;
+	for (int target : { 0, 3, 4, 499, 500, 501, 1234, 1998 }) {
+		for (; cycle <= target; cycle++)
+			ASSERT_TRUE(sequential.UpdateTable(expected));
+
+		wpilog::WPILOGReader seeking { path };
+		seeking.Start();
+		// Any time within the cycle finds it
+		ASSERT_TRUE(seeking.Seek(CycleTime(target) + 5_ms));
+		LogTable table { 0_s };
+		ASSERT_TRUE(seeking.UpdateTable(table));
+		EXPECT_EQ(table.GetTimestamp(), expected.GetTimestamp());
+		EXPECT_EQ(table.GetAll(false), expected.GetAll(false));
+		EXPECT_FALSE(table.GetAll(false).contains("/ReplayOutputs/Y"));
+	}
+	// The first seek saved the index for the later ones
+	EXPECT_TRUE(std::filesystem::exists(path + ".akitindex"));
+}
+
+TEST(WPILOGReaderTest, StaleIndexIsRebuilt) {
+	std::string path = MakeLog();
+	wpilog::WPILOGReader first { path };
+	first.Start();
+	ASSERT_TRUE(first.Seek(CycleTime(1000)));
+	std::filesystem::copy_file(path + ".akitindex", path + ".stale");
+	auto modified = std::filesystem::last_write_time(path);
+
+	// Same size and modification time, but the records are laid out
+	// differently
+	uint64_t size = std::filesystem::file_size(path);
+	MakeLog(1);
+	ASSERT_EQ(std::filesystem::file_size(path), size);
+	std::filesystem::last_write_time(path, modified);
+	std::filesystem::rename(path + ".stale", path + ".akitindex");
+
+	wpilog::WPILOGReader sequential { path, false };
+	sequential.Start();
+	LogTable expected { 0_s };
+	for (int cycle = 0; cycle <= 1000; cycle++)
+		ASSERT_TRUE(sequential.UpdateTable(expected));
+
+	wpilog::WPILOGReader seeking { path };
+	seeking.Start();
+	ASSERT_TRUE(seeking.Seek(CycleTime(1000)));
+	LogTable table { 0_s };
+	ASSERT_TRUE(seeking.UpdateTable(table));
+	EXPECT_EQ(table.GetAll(false), expected.GetAll(false));
+}
+
+TEST(WPILOGReaderTest, ReplayWindowFromEnvironment) {
+	std::string path = MakeLog();
+	SetWindow("10:11");
+	wpilog::WPILOGReader reader { path };
+	reader.Start();
+	SetWindow("");
+
+	LogTable table { 0_s };
+	ASSERT_TRUE(reader.UpdateTable(table));
+	EXPECT_EQ(table.GetTimestamp(), 10_s);
+	EXPECT_EQ(table.Get("Drive/Slow", 0.0), 0.0);
+	EXPECT_EQ(table.Get("Mode", std::string { }), "Auto");
+	int cycles = 1;
+	while (reader.UpdateTable(table))
+		cycles++;
+	EXPECT_EQ(cycles, 51);
+}
+
+TEST(WPILOGReaderTest, NegativeWindowCountsFromEnd) {
+	std::string path = MakeLog();
+	SetWindow("-1:");
+	wpilog::WPILOGReader reader { path, false };
+	reader.Start();
+	SetWindow("");
+
+	LogTable table { 0_s };
+	ASSERT_TRUE(reader.UpdateTable(table));
+	EXPECT_DOUBLE_EQ(table.GetTimestamp().value(),
+			CycleTime(CYCLE_COUNT - 51).value());
+	EXPECT_EQ(table.Get("Drive/Slow", 0.0), 1400.0);
+}
+
+TEST(WPILOGReaderTest, MalformedWindowIsIgnored) {
+	std::string path = MakeLog();
+	SetWindow("abc:10");
+	wpilog::WPILOGReader reader { path, false };
+	reader.Start();
+	SetWindow("");
+
+	// Replays the whole log rather than treating "abc" as 0 s
+	LogTable table { 0_s };
+	int cycles = 0;
+	while (reader.UpdateTable(table))
+		cycles++;
+	EXPECT_EQ(cycles, CYCLE_COUNT - 1);
+}
@@ -0,0 +1,81 @@
+// Copyright (c) 2021-2026 Littleton Robotics
+// http://github.com/Mechanical-Advantage
+//
+// Use of this source code is governed by a BSD
+// license that can be found in the LICENSE file
+// at the root directory of this project.
+
+#include <filesystem>
+#include <gtest/gtest.h>
+#include "akit/CycleArena.h"
+#include "akit/SampleStager.h"
+#include "akit/wpilog/WPILOGReader.h"
+#include "akit/wpilog/WPILOGWriter.h"
+
+using namespace akit;
+
+TEST(WPILOGWriterTest, StagedInputsReplay) {
+	std::string path = (std::filesystem::temp_directory_path()
+			/ "WPILOGWriterTest.wpilog").string();
+	wpilog::WPILOGWriter writer { path,
+			wpilog::WPILOGWriter::AdvantageScopeOpenBehavior::NEVER };
+	writer.Start();
+
+	SampleStager stager;
+	LogTable entry { 0_s };
+	// The reader only knows a cycle is complete once the next one starts, so
+	// the last cycle is not replayed
+	for (int cycle = 0; cycle < 11; cycle++) {
+		entry.SetTimestamp(units::second_t { 1 + cycle * 0.02 });
+		entry.Put("Drive/Cycle", cycle);
+		// A worker thread samples twice after each cycle starts
+		for (int sample = 0; sample < 2; sample++) {
+			LogTable staging { units::second_t { 1 + cycle * 0.02 + (sample
+					+ 1) * 0.005 } };
+			staging.Put("Gyro/Yaw", cycle * 10.0 + sample);
+			stager.Stage(staging);
+		}
+		stager.MergeInto(entry);
+		// A write after merging, like a scheduled task, replaces the samples
+		if (cycle == 5)
+			entry.Put("Gyro/Yaw", -1.0);
+		LogTable snapshot = entry.Snapshot(CycleArena::Acquire());
+		writer.PutTable(snapshot);
+	}
+	writer.End();
+
+	wpilog::WPILOGReader reader { path, false };
+	reader.Start();
+	LogTable table { 0_s };
+	for (int cycle = 0; cycle < 10; cycle++) {
+		ASSERT_TRUE(reader.UpdateTable(table));
+		EXPECT_EQ(table.Get("Drive/Cycle", -1), cycle);
+		EXPECT_EQ(table.Get("Gyro/Yaw", 0.0),
+				cycle == 5 ? -1.0 : cycle * 10.0 + 1);
+	}
+
+	// Sampled values are only written at their sample timestamps, so the
+	// yaw is written at a cycle timestamp only by the write after merging
+	wpi::log::DataLogReader log {
+			wpi::MemoryBuffer::GetFile(path).value() };
+	std::optional<int> timestampEntry;
+	std::optional<int> yawEntry;
+	int64_t cycleTimestamp = 0;
+	int cycleWrites = 0;
+	for (const auto &record : log) {
+		wpi::log::StartRecordData start;
+		if (record.IsStart() && record.GetStartData(&start)) {
+			if (start.name == LogDataReceiver::TIMESTAMP_KEY)
+				timestampEntry = start.entry;
+			else if (start.name == "/Gyro/Yaw")
+				yawEntry = start.entry;
+		} else if (record.IsControl())
+			continue;
+		else if (record.GetEntry() == timestampEntry)
+			cycleTimestamp = record.GetTimestamp();
+		else if (record.GetEntry() == yawEntry
+				&& record.GetTimestamp() == cycleTimestamp)
+			cycleWrites++;
+	}
+	EXPECT_EQ(cycleWrites, 1);
+}